@@ -0,0 +1,214 @@
+#include <bench/Bench.h>
+
+#include <voyx/Source.h>
+#include <voyx/alg/FFT.h>
+#include <voyx/alg/FIR.h>
+#include <voyx/alg/Lifter.h>
+#include <voyx/alg/SPSI.h>
+#include <voyx/alg/SRC.h>
+#include <voyx/alg/STFT.h>
+#include <voyx/alg/Vocoder.h>
+#include <voyx/etc/SIMD.h>
+
+/**
+ * Benchmarks the individual algorithms at different frame and dft sizes.
+ *
+ * The realtime factor relates the runtime to the audio duration covered by a
+ * single invocation, which is one hop for the per dft algorithms
+ * and the whole frame for the per frame algorithms.
+ **/
+void algorithmbench()
+{
+  typedef phasor_t::value_type T;
+
+  const double samplerate = 44100;
+
+  for (const size_t framesize : { 512, 1024, 2048, 4096 })
+  for (const size_t overlap : { 4, 8 })
+  for (const size_t padding : { 1, 2 })
+  {
+    const size_t hopsize = framesize / overlap;
+    const size_t dftsize = framesize * padding / 2 + 1;
+
+    const Bench::Params params =
+    {
+      { "isa", SIMD::isa() },
+      { "framesize", $$::str(framesize) },
+      { "overlap", $$::str(overlap) },
+      { "dftsize", $$::str(dftsize) }
+    };
+
+    const double frameduration = framesize / samplerate;
+    const double hopduration = hopsize / samplerate;
+
+    std::mt19937 generator(0);
+    std::normal_distribution<double> distribution;
+
+    std::vector<sample_t> samples(framesize);
+    std::vector<T> fftsamples(dftsize * 2 - 2);
+    std::vector<std::complex<T>> dfts(overlap * dftsize);
+
+    for (auto& value : samples)
+    {
+      value = static_cast<sample_t>(distribution(generator) * 0.1);
+    }
+
+    for (auto& value : fftsamples)
+    {
+      value = static_cast<T>(distribution(generator) * 0.1);
+    }
+
+    for (auto& value : dfts)
+    {
+      value = { std::abs(static_cast<T>(distribution(generator))), static_cast<T>(distribution(generator)) };
+    }
+
+    const std::vector<std::complex<T>> input(dfts);
+
+    voyx::matrix<std::complex<T>> dftmatrix(dfts, dftsize);
+    voyx::vector<std::complex<T>> dft(dfts.data(), dftsize);
+
+    {
+      FFT<T> fft(dftsize * 2 - 2);
+
+      const double seconds = Bench::measure([&]()
+      {
+        fft.fft(fftsamples, dft);
+        fft.ifft(dft, fftsamples);
+      });
+
+      Bench::report("fft", params, seconds, hopduration / seconds);
+    }
+
+    {
+      STFT<sample_t, T> stft(framesize, hopsize, dftsize);
+
+      std::vector<std::complex<T>> buffer(stft.hops().size() * dftsize);
+      std::vector<sample_t> output(framesize);
+
+      voyx::matrix<std::complex<T>> stftdfts(buffer, dftsize);
+
+      const double seconds = Bench::measure([&]()
+      {
+        stft.stft(samples, stftdfts);
+        stft.istft(stftdfts, output);
+      });
+
+      Bench::report("stft", params, seconds, frameduration / seconds);
+    }
+
+    {
+      Vocoder<T> vocoder(samplerate, framesize, hopsize, dftsize);
+
+      const double seconds = Bench::measure([&]()
+      {
+        std::copy(input.begin(), input.end(), dfts.begin());
+
+        vocoder.encode(dftmatrix);
+        vocoder.decode(dftmatrix);
+      });
+
+      Bench::report("vocoder", params, seconds, frameduration / seconds);
+    }
+
+    {
+      Lifter<T> lifter(1e-3, samplerate, dftsize * 2 - 2);
+
+      std::vector<T> envelope(dftsize);
+
+      const double seconds = Bench::measure([&]()
+      {
+        std::copy(input.begin(), input.begin() + dftsize, dfts.begin());
+
+        lifter.lowpass<$$::real>(dft, envelope);
+        lifter.divide<$$::real>(dft, envelope);
+        lifter.multiply<$$::real>(dft, envelope);
+      });
+
+      Bench::report("lifter", params, seconds, hopduration / seconds);
+    }
+
+    {
+      SPSI<T> spsi(dftsize * 2 - 2, hopsize);
+
+      const double seconds = Bench::measure([&]()
+      {
+        std::copy(input.begin(), input.begin() + dftsize, dfts.begin());
+
+        spsi(dft);
+      });
+
+      Bench::report("spsi", params, seconds, hopduration / seconds);
+    }
+
+    {
+      std::vector<std::complex<T>> buffer(dftsize);
+
+      const double seconds = Bench::measure([&]()
+      {
+        for (const double factor : { 0.5, 1.25, 1.5, 2.0 })
+        {
+          $$::interp(dft, voyx::vector<std::complex<T>>(buffer), factor);
+        }
+      });
+
+      Bench::report("interp", params, seconds, hopduration / seconds);
+    }
+
+    {
+      std::vector<T> abs(dftsize);
+
+      for (size_t i = 0; i < dftsize; ++i)
+      {
+        abs[i] = std::abs(dft[i]);
+      }
+
+      std::vector<T> product(dftsize);
+
+      const double seconds = Bench::measure([&]()
+      {
+        $$::hpsmul(voyx::vector<T>(abs), voyx::vector<T>(product), 3);
+      });
+
+      // consume the result, so that the computation cannot be omitted
+      if (!std::isfinite(std::accumulate(product.begin(), product.end(), T(0))))
+      {
+        LOG(WARNING) << "Invalid hpsmul result!";
+      }
+
+      Bench::report("hpsmul", params, seconds, hopduration / seconds);
+    }
+
+    // the time domain algorithms don't depend on the overlap and dftsize
+    if (overlap != 4 || padding != 1)
+    {
+      continue;
+    }
+
+    {
+      FIR<sample_t> fir(std::vector<sample_t>(32, sample_t(1) / 32));
+
+      std::vector<sample_t> output(framesize);
+
+      const double seconds = Bench::measure([&]()
+      {
+        fir(samples, output);
+      });
+
+      Bench::report("fir", params, seconds, frameduration / seconds);
+    }
+
+    {
+      SRC<sample_t> src({ samplerate, samplerate * 2 });
+
+      std::vector<sample_t> output(framesize * 2);
+
+      const double seconds = Bench::measure([&]()
+      {
+        src(samples, output);
+      });
+
+      Bench::report("src", params, seconds, frameduration / seconds);
+    }
+  }
+}
@@ -0,0 +1,74 @@
+#include <bench/Bench.h>
+
+#include <voyx/Source.h>
+
+INITIALIZE_EASYLOGGINGPP
+
+double Bench::measure(const std::function<void()>& callback, const std::chrono::duration<double> duration)
+{
+  // warm up caches and lazy initializations
+  callback();
+
+  size_t count = 0;
+
+  const auto start = std::chrono::steady_clock::now();
+  auto stop = start;
+
+  while (stop - start < duration)
+  {
+    callback();
+
+    ++count;
+
+    stop = std::chrono::steady_clock::now();
+  }
+
+  return std::chrono::duration<double>(stop - start).count() / count;
+}
+
+void Bench::report(const std::string& name, const Params& params, const double seconds, const double realtime)
+{
+  std::ostringstream line;
+
+  line << "{\"bench\":\"" << name << "\"";
+
+  for (const auto& [key, value] : params)
+  {
+    line << ",\"" << key << "\":\"" << value << "\"";
+  }
+
+  line << ",\"seconds\":" << std::scientific << seconds;
+
+  if (realtime > 0)
+  {
+    line << ",\"realtime\":" << std::defaultfloat << realtime;
+  }
+
+  line << "}";
+
+  std::cout << line.str() << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+  const std::map<std::string, std::function<void()>> benches =
+  {
+    { "algorithm", algorithmbench },
+    { "callback", callbackbench },
+    { "pipeline", pipelinebench },
+    { "simd", simdbench },
+    { "vocoder", vocoderbench },
+  };
+
+  const std::string filter = (argc > 1) ? argv[1] : ".*";
+
+  for (const auto& [name, bench] : benches)
+  {
+    if ($$::imatch(name, filter))
+    {
+      bench();
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
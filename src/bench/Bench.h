@@ -0,0 +1,27 @@
+#pragma once
+
+#include <voyx/Header.h>
+
+struct Bench
+{
+  typedef std::vector<std::pair<std::string, std::string>> Params;
+
+  /**
+   * Repeatedly invokes the specified callback for at least the specified duration
+   * and returns the mean duration of a single invocation in seconds.
+   **/
+  static double measure(const std::function<void()>& callback,
+                        const std::chrono::duration<double> duration = std::chrono::milliseconds(200));
+
+  /**
+   * Prints a single measurement as JSON line, optionally including
+   * the realtime factor, i.e. the processed audio duration per runtime.
+   **/
+  static void report(const std::string& name, const Params& params, const double seconds, const double realtime = 0);
+};
+
+void algorithmbench();
+void callbackbench();
+void pipelinebench();
+void simdbench();
+void vocoderbench();
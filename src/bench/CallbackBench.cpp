@@ -0,0 +1,158 @@
+#include <bench/Bench.h>
+
+#include <voyx/Source.h>
+#include <voyx/io/Sink.h>
+#include <voyx/io/Source.h>
+
+/**
+ * Source and sink with the former std::function based callback interface.
+ **/
+struct LegacySource
+{
+  virtual ~LegacySource() {}
+  virtual bool read(const size_t index, std::function<void(const voyx::vector<sample_t> frame)> callback) = 0;
+};
+
+struct LegacySink
+{
+  virtual ~LegacySink() {}
+  virtual bool write(const size_t index, const std::function<void(voyx::vector<sample_t> frame)>& callback) = 0;
+};
+
+struct LegacyMemory : LegacySource, LegacySink
+{
+  std::vector<sample_t> input, output;
+
+  LegacyMemory(const size_t framesize) : input(framesize), output(framesize) {}
+
+  bool read(const size_t index, std::function<void(const voyx::vector<sample_t> frame)> callback) override
+  {
+    callback(input);
+    return true;
+  }
+
+  bool write(const size_t index, const std::function<void(voyx::vector<sample_t> frame)>& callback) override
+  {
+    callback(output);
+    return true;
+  }
+};
+
+/**
+ * Source and sink with the current function_ref based callback interface.
+ **/
+struct Memory : Source<sample_t>, Sink<sample_t>
+{
+  std::vector<sample_t> input, output;
+
+  Memory(const size_t framesize) :
+    Source(44100, framesize, 1),
+    Sink(44100, framesize, 1),
+    input(framesize),
+    output(framesize)
+  {
+  }
+
+  bool read(const size_t index, voyx::function_ref<void(const voyx::vector<sample_t> frame)> callback) override
+  {
+    callback(input);
+    return true;
+  }
+
+  bool write(const size_t index, const voyx::vector<sample_t> frame) override
+  {
+    return false;
+  }
+
+  bool write(const size_t index, voyx::function_ref<void(voyx::vector<sample_t> frame)> callback) override
+  {
+    callback(output);
+    return true;
+  }
+};
+
+/**
+ * Compares the per-frame overhead of the former std::function based
+ * callback path with the function_ref based one,
+ * as it matters at small framesizes.
+ **/
+void callbackbench()
+{
+  const size_t frames = 1000;
+
+  for (const size_t framesize : { 64, 128, 256 })
+  {
+    const Bench::Params params =
+    {
+      { "framesize", $$::str(framesize) },
+      { "frames", $$::str(frames) }
+    };
+
+    // emulate the SyncPipeline loop capturing several references
+
+    struct
+    {
+      size_t read = 0;
+      size_t write = 0;
+    }
+    counters;
+
+    auto process = [](const voyx::vector<sample_t> input, voyx::vector<sample_t> output)
+    {
+      std::copy(input.begin(), input.end(), output.begin());
+    };
+
+    std::unique_ptr<LegacyMemory> legacy = std::make_unique<LegacyMemory>(framesize);
+
+    const double legacy_pipeline = Bench::measure([&]()
+    {
+      LegacySource* source = legacy.get();
+      LegacySink* sink = legacy.get();
+
+      for (size_t index = 0; index < frames; ++index)
+      {
+        source->read(index, [&](const voyx::vector<sample_t> input)
+        {
+          counters.read++;
+
+          sink->write(index, [&](voyx::vector<sample_t> output)
+          {
+            counters.write++;
+
+            process(input, output);
+          });
+        });
+      }
+    });
+
+    std::unique_ptr<Memory> memory = std::make_unique<Memory>(framesize);
+
+    const double pipeline = Bench::measure([&]()
+    {
+      Source<sample_t>* source = memory.get();
+      Sink<sample_t>* sink = memory.get();
+
+      for (size_t index = 0; index < frames; ++index)
+      {
+        source->read(index, [&](const voyx::vector<sample_t> input)
+        {
+          counters.read++;
+
+          sink->write(index, [&](voyx::vector<sample_t> output)
+          {
+            counters.write++;
+
+            process(input, output);
+          });
+        });
+      }
+    });
+
+    Bench::report("callback.pipeline.function", params, legacy_pipeline / frames);
+    Bench::report("callback.pipeline.function_ref", params, pipeline / frames);
+
+    LOG(INFO) << $("Callback speedup at framesize {0}: pipeline {1:.2f}x",
+                   framesize,
+                   legacy_pipeline / pipeline);
+  }
+}
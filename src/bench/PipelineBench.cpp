@@ -0,0 +1,65 @@
+#include <bench/Bench.h>
+
+#include <voyx/Source.h>
+#include <voyx/dsp/PipelineRegistry.h>
+#include <voyx/etc/SIMD.h>
+#include <voyx/io/NoiseSource.h>
+#include <voyx/io/NullSink.h>
+
+/**
+ * Renders a few seconds of noise through each pipeline as fast as possible
+ * at different frame, hop and dft sizes and reports the realtime factor.
+ **/
+void pipelinebench()
+{
+  const double samplerate = 44100;
+  const double duration = 1;
+
+  for (const size_t framesize : { 512, 1024, 2048 })
+  for (const size_t overlap : { 4, 8 })
+  for (const size_t padding : { 1, 2 })
+  {
+    const size_t hopsize = framesize / overlap;
+    const size_t dftsize = framesize * padding / 2 + 1;
+    const size_t frames = static_cast<size_t>(std::ceil(duration * samplerate / framesize));
+
+    const Bench::Params params =
+    {
+      { "isa", SIMD::isa() },
+      { "framesize", $$::str(framesize) },
+      { "overlap", $$::str(overlap) },
+      { "dftsize", $$::str(dftsize) }
+    };
+
+    PipelineRegistry::Options options;
+
+    options.samplerate = samplerate;
+    options.framesize = framesize;
+    options.hopsize = hopsize;
+    options.dftsize = dftsize;
+
+    for (const auto& name : PipelineRegistry::names())
+    {
+      auto source = std::make_shared<NoiseSource>(0.5, samplerate, framesize, frames);
+      auto sink = std::make_shared<NullSink>(samplerate, framesize, frames);
+
+      auto pipeline = PipelineRegistry::create(name, options, source, sink);
+
+      pipeline->open();
+
+      const auto timestamp = std::chrono::steady_clock::now();
+
+      pipeline->start(frames);
+
+      const double elapsed = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - timestamp).count();
+
+      pipeline->close();
+
+      const double seconds = elapsed / frames;
+      const double realtime = (framesize / samplerate) / seconds;
+
+      Bench::report("pipeline." + name, params, seconds, realtime);
+    }
+  }
+}
@@ -0,0 +1,40 @@
+#include <bench/Scalar.h>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#define VOYXSCALAR __pragma(loop(no_vector))
+#else
+#define VOYXSCALAR
+#endif
+
+void Scalar::multiply(const size_t size, const sample_t* x, const sample_t* y, double* z)
+{
+  VOYXSCALAR
+  for (size_t i = 0; i < size; ++i)
+  {
+    z[i] = x[i] * y[i];
+  }
+}
+
+void Scalar::multiplyadd(const size_t size, const double* x, const sample_t* y, sample_t* z)
+{
+  VOYXSCALAR
+  for (size_t i = 0; i < size; ++i)
+  {
+    z[i] += x[i] * y[i];
+  }
+}
+
+void Scalar::shift(const size_t size, const size_t offset, sample_t* x, const sample_t* samples)
+{
+  VOYXSCALAR
+  for (size_t i = 0; i < size - offset; ++i)
+  {
+    x[i] = x[i + offset];
+  }
+
+  VOYXSCALAR
+  for (size_t i = size - offset; i < size; ++i)
+  {
+    x[i] = samples ? samples[i - (size - offset)] : sample_t(0);
+  }
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <voyx/Header.h>
+
+/**
+ * Plain element-wise counterparts of the SIMD kernels,
+ * which serve as the baseline of the SIMD benchmark.
+ *
+ * The definitions reside in a separate translation unit,
+ * which is compiled without auto-vectorization and cannot be inlined
+ * into the benchmark, so that the baseline actually remains scalar.
+ **/
+struct Scalar
+{
+  static void multiply(const size_t size, const sample_t* x, const sample_t* y, double* z);
+  static void multiplyadd(const size_t size, const double* x, const sample_t* y, sample_t* z);
+  static void shift(const size_t size, const size_t offset, sample_t* x, const sample_t* samples = nullptr);
+};
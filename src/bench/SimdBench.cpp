@@ -0,0 +1,117 @@
+#include <bench/Bench.h>
+#include <bench/Scalar.h>
+
+#include <voyx/Source.h>
+#include <voyx/alg/STFT.h>
+#include <voyx/etc/SIMD.h>
+
+/**
+ * Compares the runtime dispatched STFT kernels with the
+ * non-vectorized scalar loops and benchmarks the complete STFT round trip.
+ **/
+void simdbench()
+{
+  LOG(INFO) << "SIMD: " << SIMD::isa();
+
+  const size_t overlap = 4;
+
+  for (const size_t framesize : { 1024, 2048, 4096 })
+  {
+    const size_t hopsize = framesize / overlap;
+    const size_t dftsize = framesize / 2 + 1;
+
+    const Bench::Params params =
+    {
+      { "isa", SIMD::isa() },
+      { "framesize", $$::str(framesize) },
+      { "overlap", $$::str(overlap) }
+    };
+
+    std::vector<sample_t> input(framesize * 2);
+    std::vector<sample_t> output(framesize * 2);
+    std::vector<sample_t> buffer(framesize * 2);
+    std::vector<sample_t> window = $$::window<sample_t>(framesize);
+    std::vector<double> frame(framesize);
+
+    std::iota(input.begin(), input.end(), sample_t(0));
+
+    const double scalar_reject = Bench::measure([&]()
+    {
+      for (size_t hop = 0; hop < framesize; hop += hopsize)
+      {
+        Scalar::multiply(framesize, input.data() + hop, window.data(), frame.data());
+      }
+    });
+
+    const double simd_reject = Bench::measure([&]()
+    {
+      for (size_t hop = 0; hop < framesize; hop += hopsize)
+      {
+        SIMD::multiply(framesize, input.data() + hop, window.data(), frame.data());
+      }
+    });
+
+    // the overlap-add restarts from silence each time,
+    // so that the accumulated values remain bounded
+    const double scalar_inject = Bench::measure([&]()
+    {
+      std::fill(output.begin(), output.end(), sample_t(0));
+
+      for (size_t hop = 0; hop < framesize; hop += hopsize)
+      {
+        Scalar::multiplyadd(framesize, frame.data(), window.data(), output.data() + hop);
+      }
+    });
+
+    const double simd_inject = Bench::measure([&]()
+    {
+      std::fill(output.begin(), output.end(), sample_t(0));
+
+      for (size_t hop = 0; hop < framesize; hop += hopsize)
+      {
+        SIMD::multiplyadd(framesize, frame.data(), window.data(), output.data() + hop);
+      }
+    });
+
+    // the same buffer shift by one block as in the STFT,
+    // once with new samples at the end and once with zeros
+    const double scalar_shift = Bench::measure([&]()
+    {
+      Scalar::shift(buffer.size(), framesize, buffer.data(), input.data());
+      Scalar::shift(buffer.size(), framesize, buffer.data());
+    });
+
+    const double simd_shift = Bench::measure([&]()
+    {
+      SIMD::shift(buffer.size(), framesize, buffer.data(), input.data());
+      SIMD::shift(buffer.size(), framesize, buffer.data());
+    });
+
+    Bench::report("stft.reject.scalar", params, scalar_reject);
+    Bench::report("stft.reject.simd", params, simd_reject);
+    Bench::report("stft.inject.scalar", params, scalar_inject);
+    Bench::report("stft.inject.simd", params, simd_inject);
+    Bench::report("stft.shift.scalar", params, scalar_shift);
+    Bench::report("stft.shift.simd", params, simd_shift);
+
+    LOG(INFO) << $("STFT kernel speedup at framesize {0}: reject {1:.2f}x, inject {2:.2f}x, shift {3:.2f}x",
+                   framesize,
+                   scalar_reject / simd_reject,
+                   scalar_inject / simd_inject,
+                   scalar_shift / simd_shift);
+
+    STFT<sample_t, phasor_t::value_type> stft(framesize, hopsize, dftsize);
+
+    std::vector<phasor_t> dfts(stft.hops().size() * stft.size());
+
+    const double roundtrip = Bench::measure([&]()
+    {
+      voyx::matrix<phasor_t> matrix(dfts, stft.size());
+
+      stft.stft(voyx::vector<sample_t>(input.data(), framesize), matrix);
+      stft.istft(matrix, voyx::vector<sample_t>(output.data(), framesize));
+    });
+
+    Bench::report("stft.roundtrip", params, roundtrip);
+  }
+}
@@ -0,0 +1,103 @@
+#include <bench/Bench.h>
+
+#include <voyx/Source.h>
+#include <voyx/alg/Vocoder.h>
+#include <voyx/etc/SIMD.h>
+
+/**
+ * Compares the batched vocoder with its scalar reference implementation
+ * in terms of the runtime and the maximum absolute deviation.
+ **/
+void vocoderbench()
+{
+  const double samplerate = 44100;
+  const size_t overlap = 4;
+
+  for (const size_t framesize : { 1024, 2048, 4096 })
+  {
+    const size_t hopsize = framesize / overlap;
+    const size_t dftsize = framesize / 2 + 1;
+
+    const Bench::Params params =
+    {
+      { "isa", SIMD::isa() },
+      { "framesize", $$::str(framesize) },
+      { "overlap", $$::str(overlap) }
+    };
+
+    std::mt19937 generator(0);
+    std::normal_distribution<double> distribution;
+
+    std::vector<std::complex<double>> input(overlap * dftsize);
+
+    for (auto& value : input)
+    {
+      value = { distribution(generator), distribution(generator) };
+    }
+
+    std::vector<std::complex<double>> batch(input);
+    std::vector<std::complex<double>> scalar(input);
+
+    voyx::matrix<std::complex<double>> batchdfts(batch, dftsize);
+    voyx::matrix<std::complex<double>> scalardfts(scalar, dftsize);
+
+    Vocoder<double> batchvocoder(samplerate, framesize, hopsize, dftsize);
+    Vocoder<double> scalarvocoder(samplerate, framesize, hopsize, dftsize);
+
+    double encodeerror = 0;
+    double decodeerror = 0;
+
+    batchvocoder.encode(batchdfts);
+
+    for (auto dft : scalardfts)
+    {
+      scalarvocoder.encode_reference(dft);
+    }
+
+    for (size_t i = 0; i < input.size(); ++i)
+    {
+      encodeerror = std::max(encodeerror, std::abs(batch[i] - scalar[i]));
+    }
+
+    batchvocoder.decode(batchdfts);
+
+    for (auto dft : scalardfts)
+    {
+      scalarvocoder.decode_reference(dft);
+    }
+
+    for (size_t i = 0; i < input.size(); ++i)
+    {
+      decodeerror = std::max(decodeerror, std::abs(batch[i] - scalar[i]));
+    }
+
+    const double batchtime = Bench::measure([&]()
+    {
+      batch = input;
+
+      batchvocoder.encode(batchdfts);
+      batchvocoder.decode(batchdfts);
+    });
+
+    const double scalartime = Bench::measure([&]()
+    {
+      scalar = input;
+
+      for (auto dft : scalardfts)
+      {
+        scalarvocoder.encode_reference(dft);
+      }
+
+      for (auto dft : scalardfts)
+      {
+        scalarvocoder.decode_reference(dft);
+      }
+    });
+
+    Bench::report("vocoder.scalar", params, scalartime);
+    Bench::report("vocoder.batch", params, batchtime);
+
+    LOG(INFO) << $("Vocoder speedup at framesize {0}: {1:.2f}x, max encode error {2:.3g}, max decode error {3:.3g}",
+                   framesize, scalartime / batchtime, encodeerror, decodeerror);
+  }
+}
@@ -0,0 +1,96 @@
+add_executable(voyx_bench)
+
+file(GLOB_RECURSE
+  HDR "${CMAKE_CURRENT_LIST_DIR}/*.h"
+      "${CMAKE_CURRENT_LIST_DIR}/../voyx/*.h")
+
+file(GLOB_RECURSE
+  CPP "${CMAKE_CURRENT_LIST_DIR}/*.cpp"
+      "${CMAKE_CURRENT_LIST_DIR}/../voyx/*.cpp")
+
+# exclude the main function of the voyx executable
+list(FILTER CPP EXCLUDE REGEX ".*/voyx/Voyx\\.cpp$")
+
+source_group(
+  TREE "${CMAKE_CURRENT_LIST_DIR}/.."
+  FILES ${HDR} ${CPP})
+
+target_sources(voyx_bench
+  PRIVATE ${HDR} ${CPP})
+
+target_include_directories(voyx_bench
+  PRIVATE "${CMAKE_CURRENT_LIST_DIR}/..")
+
+target_link_libraries(voyx_bench
+  PRIVATE voyx_options
+          cxxopts
+          dr
+          easyloggingpp
+          fmt
+          mlinterp
+          pocketfft
+          qcustomplot
+          qdft
+          qt
+          readerwriterqueue
+          rtaudio
+          rtmidi
+          sdft
+          stftpitchshift
+          xtensor
+          xtl)
+
+target_compile_features(voyx_bench
+  PRIVATE cxx_std_20)
+
+if (MSVC)
+
+  target_compile_options(voyx_bench
+    PRIVATE /fp:fast)
+
+else()
+
+  target_compile_options(voyx_bench
+    PRIVATE -ffast-math)
+
+endif()
+
+# keep the baseline of the SIMD benchmark scalar,
+# which is otherwise auto-vectorized along with the rest
+if (CMAKE_CXX_COMPILER_ID MATCHES "Clang")
+
+  set_source_files_properties("${CMAKE_CURRENT_LIST_DIR}/Scalar.cpp"
+    PROPERTIES COMPILE_OPTIONS "-fno-vectorize;-fno-slp-vectorize;-fno-builtin")
+
+elseif (CMAKE_CXX_COMPILER_ID STREQUAL "GNU")
+
+  set_source_files_properties("${CMAKE_CURRENT_LIST_DIR}/Scalar.cpp"
+    PROPERTIES COMPILE_OPTIONS "-fno-tree-vectorize;-fno-tree-loop-distribute-patterns")
+
+endif()
+
+if (MSVC)
+
+  # enable math constants like M_PI
+  target_compile_definitions(voyx_bench
+    PRIVATE _USE_MATH_DEFINES)
+
+  # disable min/max macros in windef.h
+  target_compile_definitions(voyx_bench
+    PRIVATE NOMINMAX)
+
+endif()
+
+if (UNIX)
+
+  target_link_libraries(voyx_bench
+    PRIVATE pthread)
+
+endif()
+
+if (UI)
+
+  target_compile_definitions(voyx_bench
+    PRIVATE VOYXUI)
+
+endif()
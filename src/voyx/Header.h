@@ -7,6 +7,8 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <bit>
 #include <bitset>
 #include <cctype>
 #include <chrono>
@@ -15,6 +17,7 @@
 #include <condition_variable>
 #include <csignal>
 #include <cstdlib>
+#include <exception>
 #include <filesystem>
 #include <fstream>
 #include <functional>
@@ -56,10 +59,16 @@
 #include <voyx/etc/Assert.h>
 #include <voyx/etc/Vector.h>
 #include <voyx/etc/Matrix.h>
+#include <voyx/etc/FunctionRef.h>
 
 /**
  * And finally common data type definitions.
  **/
 
 typedef float sample_t;                // time domain
+
+#ifdef VOYXFLOAT
+typedef std::complex<float> phasor_t;  // frequency domain
+#else
 typedef std::complex<double> phasor_t; // frequency domain
+#endif
@@ -1,4 +1,7 @@
 #include <voyx/Source.h>
+#include <voyx/etc/Profiler.h>
+#include <voyx/etc/Realtime.h>
+#include <voyx/etc/WAV.h>
 
 #include <voyx/io/AudioProbe.h>
 #include <voyx/io/MidiObserver.h>
@@ -16,15 +19,10 @@
 #include <voyx/io/SineSource.h>
 #include <voyx/io/SweepSource.h>
 
-#include <voyx/dsp/BypassPipeline.h>
-#include <voyx/dsp/InverseSynthPipeline.h>
-#include <voyx/dsp/QdftTestPipeline.h>
-#include <voyx/dsp/RobotPipeline.h>
-#include <voyx/dsp/SdftTestPipeline.h>
-#include <voyx/dsp/SlidingVoiceSynthPipeline.h>
-#include <voyx/dsp/StftPitchShiftPipeline.h>
-#include <voyx/dsp/StftTestPipeline.h>
-#include <voyx/dsp/VoiceSynthPipeline.h>
+#include <voyx/dsp/MultichannelPipeline.h>
+#include <voyx/dsp/ParallelRenderer.h>
+#include <voyx/dsp/PipelineRegistry.h>
+#include <voyx/dsp/SessionHost.h>
 
 #include <cxxopts.hpp>
 
@@ -51,18 +49,35 @@ int main(int argc, char** argv)
 
   options.add_options()
     ("h,help",    "Print this help")
-    ("l,list",    "List available devices for -m, -i and -o")
+    ("l,list",    "List available devices for -m, -i and -o and pipelines for -p")
+    ("p,pipeline", "Pipeline name", cxxopts::value<std::string>()->default_value("stftpitchshift"))
     ("m,midi",    "Input MIDI device name", cxxopts::value<std::string>()->default_value(""))
     ("i,input",   "Input audio device or .wav file name", cxxopts::value<std::string>()->default_value(""))
     ("o,output",  "Output audio device or .wav file name", cxxopts::value<std::string>()->default_value(""))
-    ("s,seconds", "Abort after specified number of seconds", cxxopts::value<int>()->default_value("0"))
+    ("s,seconds", "Abort after specified number of seconds, otherwise render .wav to .wav offline", cxxopts::value<int>()->default_value("0"))
     ("t,timeout", "Timeout in milliseconds", cxxopts::value<int>()->default_value("0"))
     ("a,a4",      "Concert pitch in hertz", cxxopts::value<double>()->default_value("440"))
     ("r,sr",      "Sample rate in hertz", cxxopts::value<double>()->default_value("44100"))
     ("w,window",  "STFT window size", cxxopts::value<int>()->default_value("1024"))
     ("v,overlap", "STFT window overlap", cxxopts::value<int>()->default_value("4"))
     ("b,buffer",  "Audio fifo size", cxxopts::value<int>()->default_value("100"))
-    ("d,debug",   "Enable debug mode");
+    ("k,block",   "Audio device block size for the low latency mode, 0 to disable", cxxopts::value<int>()->default_value("0"))
+    ("f,fifo",    "Real-time SCHED_FIFO priority of the DSP thread, 0 to disable", cxxopts::value<int>()->default_value("0"))
+    ("c,cpu",     "Pin the real-time DSP thread to the specified core, -1 for any", cxxopts::value<int>()->default_value("-1"))
+    ("e,export",  "Export timing statistics to the specified .json or .csv file", cxxopts::value<std::string>()->default_value(""))
+    ("z,trace",   "Write a Chrome trace of the profiling zones to the specified .json file", cxxopts::value<std::string>()->default_value(""))
+    ("j,jobs",    "Number of offline render threads for pipelines without accumulated synthesis phase, 0 for all cores", cxxopts::value<int>()->default_value("1"))
+    ("n,channels", "Number of audio channels, 0 for as many as the input .wav file has", cxxopts::value<int>()->default_value("1"))
+    ("link",      "Estimate the spectral envelope in the first channel only and reuse it in the other channels, graph and voicesynth pipelines only")
+    ("sessions",  "Number of independent pipeline sessions hosted on a shared deadline scheduler", cxxopts::value<int>()->default_value("1"))
+    ("headroom",  "Minimum CPU headroom in percent to admit another session", cxxopts::value<double>()->default_value("25"))
+    ("d,debug",   "Enable debug mode")
+    ("dftsize",   "DFT size including the nyquist bin", cxxopts::value<int>()->default_value("1025"))
+    ("factors",   "Comma separated pitch shifting factors, otherwise the pipeline default", cxxopts::value<std::vector<double>>())
+    ("quefrency", "Spectral envelope quefrency in milliseconds, otherwise the pipeline default", cxxopts::value<double>())
+    ("workers",   "Number of worker threads of the asynchronous pipelines, 0 for all cores", cxxopts::value<int>()->default_value("0"))
+    ("hopthreads", "Number of threads per frame of the STFT pipelines at high overlaps, 0 for all cores", cxxopts::value<int>()->default_value("1"))
+    ("bench",     "Render noise through each or the specified pipeline as fast as possible and print the throughput");
 
   const auto args = options.parse(argc, argv);
 
@@ -99,6 +114,17 @@ int main(int argc, char** argv)
            << std::endl
            << midi();
 
+    result << std::endl;
+
+    result << "~ AVAILABLE PIPELINES ~"
+           << std::endl
+           << std::endl;
+
+    for (const auto& name : PipelineRegistry::names())
+    {
+      result << name << std::endl;
+    }
+
     std::cout << result.str();
 
     return OK;
@@ -117,59 +143,344 @@ int main(int argc, char** argv)
   const size_t framesize = std::abs(args["window"].as<int>());
   const size_t hopsize = framesize / std::abs(args["overlap"].as<int>());
   const size_t buffersize = std::abs(args["buffer"].as<int>());
+  const size_t devicesize = std::abs(args["block"].as<int>());
+  const size_t dftsize = std::abs(args["dftsize"].as<int>());
+  const size_t jobs = std::abs(args["jobs"].as<int>());
+  const bool linked = args.count("link");
+  const size_t sessions = std::max(std::abs(args["sessions"].as<int>()), 1);
+  const double headroom = std::abs(args["headroom"].as<double>()) * 1e-2;
+  const std::string stats = args["export"].as<std::string>();
+  const std::string trace = args["trace"].as<std::string>();
+
+  Realtime::Options realtime;
+  realtime.priority = std::abs(args["fifo"].as<int>());
+  realtime.cpu = args["cpu"].as<int>();
 
   const bool debug = args.count("debug");
 
-  std::shared_ptr<Source<>> source;
-  std::shared_ptr<Sink<>> sink;
+  const std::string name = args["pipeline"].as<std::string>();
 
-  if (input.empty())
+  if (!PipelineRegistry::contains(name))
   {
-    source = std::make_shared<NullSource>(samplerate, framesize, buffersize);
+    LOG(ERROR) << $("Unknown pipeline \"{0}\", expected one of {1}!",
+                    name, $$::join(PipelineRegistry::names(), ", "));
+
+    return NOK;
   }
-  else if ($$::imatch(input, "noise"))
+
+  if (linked && !PipelineRegistry::linkable(name))
   {
-    source = std::make_shared<NoiseSource>(0.5, samplerate, framesize, buffersize);
+    LOG(ERROR) << $("The pipeline \"{0}\" doesn't support linked channels, expected one of {1}!",
+                    name, $$::join(PipelineRegistry::linkables(), ", "));
+
+    return NOK;
   }
-  else if ($$::imatch(input, "null"))
+
+  PipelineRegistry::Options params;
+
+  params.samplerate = samplerate;
+  params.framesize = framesize;
+  params.hopsize = hopsize;
+  params.dftsize = dftsize;
+  params.workers = std::abs(args["workers"].as<int>());
+  params.hopthreads = std::abs(args["hopthreads"].as<int>());
+
+  if (args.count("factors"))
   {
-    source = std::make_shared<NullSource>(samplerate, framesize, buffersize);
+    params.factors = args["factors"].as<std::vector<double>>();
   }
-  else if ($$::imatch(input, "sine"))
+
+  if (args.count("quefrency"))
   {
-    source = std::make_shared<SineSource>(0.5, concertpitch, samplerate, framesize, buffersize);
+    params.quefrency = args["quefrency"].as<double>() * 1e-3;
   }
-  else if ($$::imatch(input, "sweep"))
+
+  if (args.count("bench"))
   {
-    source = std::make_shared<SweepSource>(0.5, std::make_pair(concertpitch / 2, concertpitch * 2), 10, samplerate, framesize, buffersize);
+    const double duration = seconds ? seconds : 10;
+    const size_t frames = static_cast<size_t>(std::ceil(duration * samplerate / framesize));
+
+    const std::vector<std::string> names = args.count("pipeline")
+      ? std::vector<std::string>{ name }
+      : PipelineRegistry::names();
+
+    std::cout << "~ PIPELINE BENCHMARK ~" << std::endl << std::endl;
+
+    for (const auto& name : names)
+    {
+      try
+      {
+        auto pipe = PipelineRegistry::create(name, params,
+          std::make_shared<NoiseSource>(0.5, samplerate, framesize, buffersize),
+          std::make_shared<NullSink>(samplerate, framesize, buffersize));
+
+        pipe->open();
+
+        const auto timestamp = std::chrono::steady_clock::now();
+
+        pipe->start(frames);
+
+        const double elapsed = std::chrono::duration<double>(
+          std::chrono::steady_clock::now() - timestamp).count();
+
+        pipe->close();
+
+        std::cout << $("{0:<20} {1:>10.1f}x realtime {2:>10.3f} ms per frame",
+                       name, duration / elapsed, elapsed / frames * 1e+3) << std::endl;
+      }
+      catch (const std::exception& exception)
+      {
+        std::cout << $("{0:<20} failed: {1}", name, exception.what()) << std::endl;
+      }
+    }
+
+    return OK;
   }
-  else if ($$::imatch(input, ".*.wav"))
+
+  // render the whole input file exactly once and as fast as possible
+  const bool offline = !seconds && $$::imatch(input, ".*.wav") && $$::imatch(output, ".*.wav");
+
+  // exchange single hops instead of whole windows with a small device block size,
+  // so that the latency is no longer dominated by the window size
+  const bool lowlatency = devicesize > 0 && !offline;
+  const size_t blocksize = lowlatency ? hopsize : framesize;
+
+  if (lowlatency)
   {
-    source = std::make_shared<FileSource>(input, samplerate, framesize, buffersize);
+    LOG(INFO) << $("Low latency mode: device block {0}, pipeline block {1}, window {2}",
+                   devicesize, blocksize, framesize);
   }
-  else
+
+  size_t channels = std::abs(args["channels"].as<int>());
+
+  if (!channels)
   {
-    source = std::make_shared<AudioSource>(input, samplerate, framesize, buffersize);
+    channels = $$::imatch(input, ".*.wav") ? WAV::channels(input) : 1;
   }
 
-  if (output.empty())
+  // both the channels and the sessions are processed frame by frame via SyncPipeline::process
+  if ((sessions > 1 || channels > 1) && !PipelineRegistry::synchronous(name))
   {
-    sink = std::make_shared<NullSink>(samplerate, framesize, buffersize);
+    LOG(ERROR) << $("The asynchronous pipeline \"{0}\" supports neither multiple channels nor sessions!",
+                    name);
+
+    return NOK;
   }
-  else if ($$::imatch(output, "null"))
+
+  // each session of the session host gets its own source and sink
+  auto newsource = [&]() -> std::shared_ptr<Source<>>
+  {
+    if (input.empty())
+    {
+      return std::make_shared<NullSource>(samplerate, blocksize, buffersize, channels);
+    }
+    else if ($$::imatch(input, "noise"))
+    {
+      return std::make_shared<NoiseSource>(0.5, samplerate, blocksize, buffersize);
+    }
+    else if ($$::imatch(input, "null"))
+    {
+      return std::make_shared<NullSource>(samplerate, blocksize, buffersize, channels);
+    }
+    else if ($$::imatch(input, "sine"))
+    {
+      return std::make_shared<SineSource>(0.5, concertpitch, samplerate, blocksize, buffersize);
+    }
+    else if ($$::imatch(input, "sweep"))
+    {
+      return std::make_shared<SweepSource>(0.5, std::make_pair(concertpitch / 2, concertpitch * 2), 10, samplerate, blocksize, buffersize);
+    }
+    else if ($$::imatch(input, ".*.wav"))
+    {
+      return std::make_shared<FileSource>(input, samplerate, blocksize, buffersize, !offline, channels);
+    }
+    else
+    {
+      return std::make_shared<AudioSource>(input, samplerate, blocksize, buffersize, devicesize, channels);
+    }
+  };
+
+  auto newsink = [&](const std::string& output) -> std::shared_ptr<Sink<>>
   {
-    sink = std::make_shared<NullSink>(samplerate, framesize, buffersize);
+    if (output.empty())
+    {
+      return std::make_shared<NullSink>(samplerate, blocksize, buffersize, channels);
+    }
+    else if ($$::imatch(output, "null"))
+    {
+      return std::make_shared<NullSink>(samplerate, blocksize, buffersize, channels);
+    }
+    else if ($$::imatch(output, ".*.wav"))
+    {
+      return std::make_shared<FileSink>(output, samplerate, blocksize, buffersize, channels);
+    }
+    else
+    {
+      return std::make_shared<AudioSink>(output, samplerate, blocksize, buffersize, devicesize, channels);
+    }
+  };
+
+  auto unsupported = [&](std::shared_ptr<Source<>> source)
+  {
+    if (source->channels() == channels)
+    {
+      return false;
+    }
+
+    LOG(ERROR) << $("The input \"{0}\" provides {1} instead of {2} channels!",
+                    input, source->channels(), channels);
+
+    return true;
+  };
+
+  std::shared_ptr<MidiObserver> observer = midi.empty() ? nullptr : std::make_shared<MidiObserver>(midi, concertpitch);
+
+  params.midi = observer;
+
+  // only pipelines without accumulated synthesis phase can be rendered in segments
+  const bool segmented = offline && jobs != 1 && channels == 1 && sessions == 1 && PipelineRegistry::segmentable(name);
+
+  // the sessions and the segments already occupy all cores,
+  // so their pipelines must not spawn further threads per channel or per hop
+  const bool nested = sessions > 1 || segmented;
+
+  if (params.hopthreads != 1 && (nested || channels > 1))
+  {
+    LOG(WARNING) << $("Ignoring hopthreads {0}, since the {1} already run in parallel!",
+                      params.hopthreads, nested ? (sessions > 1 ? "sessions" : "segments") : "channels");
   }
-  else if ($$::imatch(output, ".*.wav"))
+
+  auto pipeline = [&](std::shared_ptr<Source<>> source, std::shared_ptr<Sink<>> sink) -> std::shared_ptr<Pipeline<>>
   {
-    sink = std::make_shared<FileSink>(output, samplerate, framesize, buffersize);
+    PipelineRegistry::Options options = params;
+
+    if (nested || source->channels() > 1)
+    {
+      options.hopthreads = 1;
+    }
+
+    if (source->channels() == 1)
+    {
+      return PipelineRegistry::create(name, options, source, sink);
+    }
+
+    // one pipeline instance per channel, all of them sharing the same link if any
+    const auto link = linked ? std::make_shared<ChannelLink>(dftsize) : nullptr;
+
+    return std::make_shared<MultichannelPipeline>([&name, options, link](const size_t channel, auto source, auto sink)
+    {
+      PipelineRegistry::Options channeloptions = options;
+
+      channeloptions.link = link;
+      channeloptions.channel = channel;
+      channeloptions.plot = channel ? nullptr : options.plot;
+
+      return PipelineRegistry::create(name, channeloptions, source, sink);
+    },
+    linked, source, sink, nested ? 1 : 0);
+  };
+
+  if (!trace.empty())
+  {
+    if (Profiler::enabled())
+    {
+      Profiler::trace(1 << 20);
+    }
+    else
+    {
+      LOG(WARNING) << "Profiling zones are disabled, rebuild with PROFILE=ON!";
+    }
   }
-  else
+
+  if (sessions > 1)
   {
-    sink = std::make_shared<AudioSink>(output, samplerate, framesize, buffersize);
+    SessionHost host(headroom);
+
+    // distinct output files per session, e.g. out.0.wav, out.1.wav and so on
+    auto path = [&](const size_t session)
+    {
+      return $$::imatch(output, ".*.wav")
+        ? std::filesystem::path(output).replace_extension($("{0}.wav", session)).string()
+        : output;
+    };
+
+    if (offline)
+    {
+      size_t frames = 0;
+
+      for (size_t session = 0; session < sessions; ++session)
+      {
+        auto source = newsource();
+
+        if (unsupported(source))
+        {
+          return NOK;
+        }
+
+        if (host.admit(pipeline(source, newsink(path(session)))))
+        {
+          frames = std::max(frames, source->frames());
+        }
+      }
+
+      host.start(frames);
+    }
+    else
+    {
+      Realtime::configure(realtime);
+
+      host.start();
+
+      for (size_t session = 0; session < sessions; ++session)
+      {
+        auto source = newsource();
+
+        if (unsupported(source))
+        {
+          return NOK;
+        }
+
+        if (!host.admit(pipeline(source, newsink(path(session)))))
+        {
+          break;
+        }
+
+        // let the load measurement settle before admitting the next session
+        std::this_thread::sleep_for(source->timeout() * 10);
+      }
+
+      LOG(INFO) << $("Hosting {0} of {1} sessions.", host.size(), sessions);
+
+      if (seconds > 0)
+      {
+        std::this_thread::sleep_for(std::chrono::seconds(seconds));
+      }
+      else
+      {
+        std::unique_lock lock(mutex);
+        condition.wait(lock);
+      }
+
+      host.stop();
+    }
+
+    Profiler::report();
+
+    if (!trace.empty() && Profiler::enabled())
+    {
+      Profiler::dump(trace);
+    }
+
+    return OK;
   }
 
-  std::shared_ptr<MidiObserver> observer = midi.empty() ? nullptr : std::make_shared<MidiObserver>(midi, concertpitch);
+  std::shared_ptr<Source<>> source = newsource();
+  std::shared_ptr<Sink<>> sink = newsink(output);
+
+  if (unsupported(source))
+  {
+    return NOK;
+  }
 
   #ifdef VOYXUI
   std::shared_ptr<Plot> plot = !debug ? nullptr : std::make_shared<QPlot>(source->timeout());
@@ -177,21 +488,53 @@ int main(int argc, char** argv)
   std::shared_ptr<Plot> plot = nullptr;
   #endif
 
-  const size_t dftsize = 1*1024 + /* nyquist */ 1;
+  params.plot = plot;
+
+  if (offline && jobs != 1 && channels > 1)
+  {
+    LOG(INFO) << "Rendering the channels instead of the segments in parallel.";
+  }
+  else if (offline && jobs != 1 && !segmented)
+  {
+    LOG(WARNING) << $("Rendering serially, since the segments of the pipeline \"{0}\" would not be phase coherent!", name);
+  }
+
+  if (segmented)
+  {
+    // segments are rendered concurrently, so don't plot
+    params.plot = nullptr;
+
+    const size_t warmup = (dftsize * 2 - 2) / framesize + 2;
+    const size_t crossfade = 1;
+
+    ParallelRenderer renderer(pipeline, warmup, crossfade, jobs ? jobs : std::thread::hardware_concurrency());
+
+    renderer(source, sink);
 
-  // auto pipe = std::make_shared<BypassPipeline>(source, sink);
-  // auto pipe = std::make_shared<InverseSynthPipeline>(samplerate, framesize, hopsize, source, sink, observer, plot);
-  // auto pipe = std::make_shared<QdftTestPipeline>(samplerate, framesize, source, sink, observer, plot);
-  // auto pipe = std::make_shared<RobotPipeline>(samplerate, framesize, dftsize, source, sink, observer, plot);
-  // auto pipe = std::make_shared<SdftTestPipeline>(samplerate, framesize, dftsize, source, sink, observer, plot);
-  // auto pipe = std::make_shared<SlidingVoiceSynthPipeline>(samplerate, framesize, dftsize, source, sink, observer, plot);
-  auto pipe = std::make_shared<StftPitchShiftPipeline>(samplerate, framesize, hopsize, dftsize, source, sink, observer, plot);
-  // auto pipe = std::make_shared<StftTestPipeline>(samplerate, framesize, hopsize, dftsize, source, sink, observer, plot);
-  // auto pipe = std::make_shared<VoiceSynthPipeline>(samplerate, framesize, hopsize, dftsize, source, sink, observer, plot);
+    Profiler::report();
+
+    if (!trace.empty() && Profiler::enabled())
+    {
+      Profiler::dump(trace);
+    }
+
+    return OK;
+  }
+
+  if (!offline)
+  {
+    Realtime::configure(realtime);
+  }
+
+  auto pipe = pipeline(source, sink);
 
   pipe->open();
 
-  if (seconds > 0)
+  if (offline)
+  {
+    pipe->start(source->frames());
+  }
+  else if (seconds > 0)
   {
     pipe->start(
       std::chrono::seconds(seconds),
@@ -216,5 +559,17 @@ int main(int argc, char** argv)
 
   pipe->close();
 
+  if (!stats.empty())
+  {
+    pipe->dump(stats);
+  }
+
+  Profiler::report();
+
+  if (!trace.empty() && Profiler::enabled())
+  {
+    Profiler::dump(trace);
+  }
+
   return OK;
 }
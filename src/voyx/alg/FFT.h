@@ -1,9 +1,23 @@
 #pragma once
 
 #include <voyx/Header.h>
+#include <voyx/etc/Heap.h>
 
 #include <pocketfft_hdronly.h>
 
+/**
+ * Real-valued FFT implementation based on a prebuilt pocketfft plan.
+ *
+ * In contrast to pocketfft::r2c and pocketfft::c2r, the plan is created once
+ * and the transforms are computed in place in the provided output buffers,
+ * so there is neither a plan cache lookup nor a temporary output buffer per call.
+ *
+ * However, pocketfft_r::exec still allocates its internal scratch buffer per call
+ * and provides no way to pass a preallocated one, so it is exempted from the Heap tracker.
+ *
+ * The plans are shared between all instances of the same size, e.g. of concurrent
+ * pipeline sessions, since pocketfft plans are immutable once created.
+ **/
 template<typename T>
 class FFT
 {
@@ -14,7 +28,9 @@ public:
     fullsize(framesize),
     halfsize(framesize / 2 + /* nyquist */ 1)
   {
-    voyxassert(framesize && !(framesize & (framesize - 1))); // power of two
+    voyxassert(framesize > 1 && framesize % 2 == 0); // even, see forward and backward
+
+    plan = share(framesize);
   }
 
   size_t framesize() const
@@ -32,15 +48,7 @@ public:
     voyxassert(samples.size() == framesize());
     voyxassert(dft.size() == dftsize());
 
-    pocketfft::r2c(
-      { samples.size() },
-      { sizeof(T) },
-      { sizeof(std::complex<T>) },
-      0,
-      true,
-      samples.data(),
-      dft.data(),
-      T(1) / samples.size());
+    forward(samples.data(), dft.data());
   }
 
   void fft(const voyx::matrix<T> samples, voyx::matrix<std::complex<T>> dfts) const
@@ -49,18 +57,10 @@ public:
     voyxassert(samples.stride() == framesize());
     voyxassert(dfts.stride() == dftsize());
 
-    const ptrdiff_t X = samples.stride() * sizeof(T);
-    const ptrdiff_t Y = dfts.stride() * sizeof(std::complex<T>);
-
-    pocketfft::r2c(
-      { samples.stride(), samples.size() },
-      { sizeof(T), X },
-      { sizeof(std::complex<T>), Y },
-      0,
-      true,
-      samples.data(),
-      dfts.data(),
-      T(1) / samples.stride());
+    for (size_t i = 0; i < samples.size(); ++i)
+    {
+      forward(samples[i].data(), dfts[i].data());
+    }
   }
 
   void ifft(const voyx::vector<std::complex<T>> dft, voyx::vector<T> samples) const
@@ -68,15 +68,7 @@ public:
     voyxassert(samples.size() == framesize());
     voyxassert(dft.size() == dftsize());
 
-    pocketfft::c2r(
-      { samples.size() },
-      { sizeof(std::complex<T>) },
-      { sizeof(T) },
-      0,
-      false,
-      dft.data(),
-      samples.data(),
-      T(1));
+    backward(dft.data(), samples.data());
   }
 
   void ifft(const voyx::matrix<std::complex<T>> dfts, voyx::matrix<T> samples) const
@@ -85,18 +77,10 @@ public:
     voyxassert(samples.stride() == framesize());
     voyxassert(dfts.stride() == dftsize());
 
-    const ptrdiff_t X = dfts.stride() * sizeof(std::complex<T>);
-    const ptrdiff_t Y = samples.stride() * sizeof(T);
-
-    pocketfft::c2r(
-      { samples.stride(), samples.size() },
-      { sizeof(std::complex<T>), X },
-      { sizeof(T), Y },
-      0,
-      false,
-      dfts.data(),
-      samples.data(),
-      T(1));
+    for (size_t i = 0; i < samples.size(); ++i)
+    {
+      backward(dfts[i].data(), samples[i].data());
+    }
   }
 
 private:
@@ -104,4 +88,84 @@ private:
   const size_t fullsize;
   const size_t halfsize;
 
+  std::shared_ptr<pocketfft::detail::pocketfft_r<T>> plan;
+
+  /**
+   * Returns the plan of the specified size, which lives as long as any instance uses it.
+   **/
+  static std::shared_ptr<pocketfft::detail::pocketfft_r<T>> share(const size_t framesize)
+  {
+    static std::mutex mutex;
+    static std::map<size_t, std::weak_ptr<pocketfft::detail::pocketfft_r<T>>> plans;
+
+    std::lock_guard lock(mutex);
+
+    auto plan = plans[framesize].lock();
+
+    if (plan == nullptr)
+    {
+      plan = std::make_shared<pocketfft::detail::pocketfft_r<T>>(framesize);
+      plans[framesize] = plan;
+    }
+
+    return plan;
+  }
+
+  /**
+   * Computes the forward transform in the output buffer, which
+   * has enough space for the intermediate halfcomplex representation
+   * { r0, r1, i1, r2, i2, ..., rn } and unpacks it from back to front.
+   **/
+  void forward(const T* samples, std::complex<T>* dft) const
+  {
+    T* const data = reinterpret_cast<T*>(dft);
+
+    std::copy(samples, samples + fullsize, data);
+
+    {
+      Heap::Exempt exempt;
+      plan->exec(data, T(1) / fullsize, true);
+    }
+
+    const size_t n = fullsize;
+
+    data[n + 1] = 0;
+    data[n] = data[n - 1];
+
+    for (size_t i = n / 2 - 1; i > 0; --i)
+    {
+      const T imag = data[i * 2];
+      const T real = data[i * 2 - 1];
+
+      data[i * 2 + 1] = imag;
+      data[i * 2] = real;
+    }
+
+    data[1] = 0;
+  }
+
+  /**
+   * Packs the input spectrum into the halfcomplex representation
+   * inside the output buffer and computes the backward transform in place.
+   **/
+  void backward(const std::complex<T>* dft, T* samples) const
+  {
+    const size_t n = fullsize;
+
+    samples[0] = dft[0].real();
+
+    for (size_t i = 1; i < n / 2; ++i)
+    {
+      samples[i * 2 - 1] = dft[i].real();
+      samples[i * 2] = dft[i].imag();
+    }
+
+    samples[n - 1] = dft[n / 2].real();
+
+    {
+      Heap::Exempt exempt;
+      plan->exec(samples, T(1), false);
+    }
+  }
+
 };
@@ -103,14 +103,46 @@ public:
     }
     else
     {
-      std::ostringstream error;
+      unsupported();
+    }
+  }
+
+  /**
+   * Converts interleaved samples of the specified number of channels,
+   * supporting the same integer ratios as the single channel conversion.
+   **/
+  void operator()(const voyx::vector<T> src, voyx::vector<T> dst, const size_t channels) const
+  {
+    if (channels == 1)
+    {
+      (*this)(src, dst);
+      return;
+    }
+
+    voyxassert(src.size() % channels == 0);
+    voyxassert(dst.size() == static_cast<size_t>(src.size() * quotient()));
+
+    const bool upsample = samplerates.second >= samplerates.first;
+
+    const double ratio = upsample
+      ? samplerates.second / samplerates.first
+      : samplerates.first / samplerates.second;
+
+    const size_t factor = static_cast<size_t>(ratio);
 
-      error
-        << "Unsupported sample rate conversion "
-        << "from " << samplerates.first << " Hz "
-        << "to " << samplerates.second << " Hz!";
+    if (factor != ratio || factor < 1 || factor > 4)
+    {
+      unsupported();
+    }
+
+    for (size_t j = 0; j < dst.size() / channels; ++j)
+    {
+      const size_t i = upsample ? j / factor : j * factor;
 
-      throw std::runtime_error(error.str());
+      for (size_t k = 0; k < channels; ++k)
+      {
+        dst[j * channels + k] = src[i * channels + k];
+      }
     }
   }
 
@@ -118,4 +150,16 @@ private:
 
   std::pair<double, double> samplerates;
 
+  void unsupported() const
+  {
+    std::ostringstream error;
+
+    error
+      << "Unsupported sample rate conversion "
+      << "from " << samplerates.first << " Hz "
+      << "to " << samplerates.second << " Hz!";
+
+    throw std::runtime_error(error.str());
+  }
+
 };
@@ -3,9 +3,18 @@
 #include <voyx/Header.h>
 #include <voyx/alg/FFT.h>
 #include <voyx/etc/Convert.Window.h>
+#include <voyx/etc/SIMD.h>
+#include <voyx/etc/ThreadPool.h>
 
 /**
  * Short-Time Fourier Transform implementation.
+ *
+ * The framesize specifies the synthesis window size and thus the latency,
+ * while the optional blocksize specifies the number of samples processed
+ * per call, e.g. a single hop in the low latency mode.
+ *
+ * Optionally the per-hop transforms of a block are distributed across a thread pool,
+ * which pays off at high overlaps, i.e. with many hops per block.
  **/
 template <typename T, typename F>
 class STFT
@@ -13,14 +22,17 @@ class STFT
 
 public:
 
-  STFT(const size_t framesize, const size_t hopsize, const size_t dftsize) :
+  STFT(const size_t framesize, const size_t hopsize, const size_t dftsize, const size_t blocksize = 0) :
     framesize(framesize),
     hopsize(hopsize),
     dftsize(dftsize),
+    blocksize(blocksize ? blocksize : framesize),
     fft(dftsize * 2 - /* nyquist */ 2)
   {
     voyxassert(fft.dftsize() == dftsize);
     voyxassert(fft.framesize() >= framesize);
+    voyxassert(this->blocksize % hopsize == 0);
+    voyxassert(this->blocksize <= framesize);
 
     if (framesize == fft.framesize())
     {
@@ -39,13 +51,13 @@ public:
     std::transform(windows.synthesis.begin(), windows.synthesis.end(), windows.synthesis.begin(),
       [unitygain](T value) { return value * unitygain; });
 
-    for (size_t hop = 0; (hop + framesize) < (framesize * 2); hop += hopsize)
+    for (size_t hop = 0; hop < this->blocksize; hop += hopsize)
     {
       data.hops.push_back(hop);
     }
 
-    data.input.resize(fft.framesize()  + framesize);
-    data.output.resize(fft.framesize() + framesize);
+    data.input.resize(fft.framesize()  + this->blocksize);
+    data.output.resize(fft.framesize() + this->blocksize);
     data.frames.resize(fft.framesize() * data.hops.size());
   }
 
@@ -59,64 +71,73 @@ public:
     return data.hops;
   }
 
+  void parallelize(std::shared_ptr<ThreadPool> pool)
+  {
+    this->pool = pool;
+  }
+
+  /**
+   * Returns the delay between input and output in samples.
+   **/
+  size_t latency() const
+  {
+    return framesize;
+  }
+
   const voyx::vector<T> signal() const
   {
-    return voyx::vector(data.input.data() + framesize, fft.framesize());
+    return voyx::vector(data.input.data() + blocksize, fft.framesize());
   }
 
   void stft(const voyx::vector<T> samples, voyx::matrix<std::complex<F>> dfts)
   {
-    voyxassert(samples.size() == framesize);
+    voyxassert(samples.size() == blocksize);
     voyxassert(dfts.size() == data.hops.size());
     voyxassert(dfts.stride() == fft.dftsize());
 
-    for (size_t i = 0; i < fft.framesize(); ++i)
-    {
-      const size_t j = i + framesize;
-
-      data.input[i] = data.input[j];
-    }
-
-    for (size_t i = 0; i < framesize; ++i)
-    {
-      const size_t j = i + fft.framesize();
-
-      data.input[j] = samples[i];
-    }
+    SIMD::shift(data.input.size(), blocksize, data.input.data(), samples.data());
 
     voyx::matrix<F> frames(data.frames, fft.framesize());
 
-    reject(frames, data.input, data.hops, windows.analysis);
+    foreach(data.hops.size(), [&](const size_t first, const size_t last)
+    {
+      for (size_t i = first; i < last; ++i)
+      {
+        reject(frames[i], data.input, data.hops[i], windows.analysis);
 
-    fft.fft(frames, dfts);
+        fft.fft(frames[i], dfts[i]);
+      }
+    });
   }
 
   void istft(const voyx::matrix<std::complex<F>> dfts, voyx::vector<T> samples)
   {
     voyxassert(dfts.size() == data.hops.size());
     voyxassert(dfts.stride() == fft.dftsize());
-    voyxassert(samples.size() == framesize);
+    voyxassert(samples.size() == blocksize);
 
     voyx::matrix<F> frames(data.frames, fft.framesize());
 
-    fft.ifft(dfts, frames);
-
-    inject(frames, data.output, data.hops, windows.synthesis);
-
-    for (size_t i = 0; i < framesize; ++i)
+    foreach(data.hops.size(), [&](const size_t first, const size_t last)
     {
-      const size_t j = i + fft.framesize() - framesize;
+      for (size_t i = first; i < last; ++i)
+      {
+        fft.ifft(dfts[i], frames[i]);
+      }
+    });
 
-      samples[i] = data.output[j];
+    // the overlap-add remains serial, since adjacent hops overlap
+    for (size_t i = 0; i < data.hops.size(); ++i)
+    {
+      inject(frames[i], data.output, data.hops[i], windows.synthesis);
     }
 
-    for (size_t i = 0; i < fft.framesize(); ++i)
-    {
-      const size_t j = i + framesize;
+    std::copy(
+      data.output.begin() + fft.framesize() - framesize,
+      data.output.begin() + fft.framesize() - framesize + blocksize,
+      samples.data());
 
-      data.output[i] = data.output[j];
-      data.output[j] = 0;
-    }
+    SIMD::shift(data.output.size(), blocksize, data.output.data());
   }
 
 private:
@@ -124,9 +145,12 @@ private:
   const size_t framesize;
   const size_t hopsize;
   const size_t dftsize;
+  const size_t blocksize;
 
   const FFT<F> fft;
 
+  std::shared_ptr<ThreadPool> pool;
+
   struct
   {
     std::vector<T> analysis;
@@ -143,32 +167,26 @@ private:
   }
   data;
 
-  static void reject(voyx::matrix<F> frames, const voyx::vector<T> input, const std::vector<size_t>& hops, const std::vector<T>& window)
+  template<typename C>
+  void foreach(const size_t count, C&& callback)
   {
-    for (size_t i = 0; i < hops.size(); ++i)
+    if (pool == nullptr || count < 2)
     {
-      const auto hop = hops[i];
-      auto frame = frames[i];
-
-      for (size_t j = 0; j < window.size(); ++j)
-      {
-        frame[j] = input[hop + j] * window[j];
-      }
+      callback(0, count);
+      return;
     }
+
+    pool->chunks(count, callback);
   }
 
-  static void inject(const voyx::matrix<F> frames, voyx::vector<T> output, const std::vector<size_t>& hops, const std::vector<T>& window)
+  static void reject(voyx::vector<F> frame, const voyx::vector<T> input, const size_t hop, const std::vector<T>& window)
   {
-    for (size_t i = 0; i < hops.size(); ++i)
-    {
-      const auto hop = hops[i];
-      const auto frame = frames[i];
+    SIMD::multiply(window.size(), input.data() + hop, window.data(), frame.data());
+  }
 
-      for (size_t j = 0; j < window.size(); ++j)
-      {
-        output[hop + j] += frame[j] * window[j];
-      }
-    }
+  static void inject(const voyx::vector<F> frame, voyx::vector<T> output, const size_t hop, const std::vector<T>& window)
+  {
+    SIMD::multiplyadd(window.size(), frame.data(), window.data(), output.data() + hop);
   }
 
 };
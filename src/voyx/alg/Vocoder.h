@@ -1,6 +1,7 @@
 #pragma once
 
 #include <voyx/Header.h>
+#include <voyx/etc/SIMD.h>
 
 template<typename T>
 class Vocoder
@@ -31,6 +32,7 @@ public:
       }
 
       analysis.buffer.resize(dftsize.value());
+      analysis.delta.resize(dftsize.value());
       synthesis.buffer.resize(dftsize.value());
     }
     else
@@ -43,15 +45,19 @@ public:
       synthesis.timeshift.resize(framedftsize);
 
       analysis.buffer.resize(framedftsize);
+      analysis.delta.resize(framedftsize);
       synthesis.buffer.resize(framedftsize);
     }
   }
 
   void encode(voyx::matrix<std::complex<T>> dfts)
   {
+    // batch magnitude and phase estimation across all hops at once
+    SIMD::absarg(dfts.size() * dfts.stride(), dfts.data());
+
     for (auto dft : dfts)
     {
-      encode(dft);
+      analyze(dft);
     }
   }
 
@@ -59,11 +65,31 @@ public:
   {
     for (auto dft : dfts)
     {
-      decode(dft);
+      synthesize(dft);
     }
+
+    // batch polar to cartesian conversion across all hops at once
+    SIMD::polar(dfts.size() * dfts.stride(), dfts.data());
   }
 
   void encode(voyx::vector<std::complex<T>> dft)
+  {
+    SIMD::absarg(dft.size(), dft.data());
+
+    analyze(dft);
+  }
+
+  void decode(voyx::vector<std::complex<T>> dft)
+  {
+    synthesize(dft);
+
+    SIMD::polar(dft.size(), dft.data());
+  }
+
+  /**
+   * Scalar reference implementation of the encode function.
+   **/
+  void encode_reference(voyx::vector<std::complex<T>> dft)
   {
     T frequency,
       phase,
@@ -84,7 +110,10 @@ public:
     }
   }
 
-  void decode(voyx::vector<std::complex<T>> dft)
+  /**
+   * Scalar reference implementation of the decode function.
+   **/
+  void decode_reference(voyx::vector<std::complex<T>> dft)
   {
     T frequency,
       phase,
@@ -117,6 +146,7 @@ private:
   struct
   {
     std::vector<T> buffer;
+    std::vector<T> delta;
   }
   analysis;
 
@@ -127,6 +157,60 @@ private:
   }
   synthesis;
 
+  /**
+   * Converts the estimated phase values { abs, arg }
+   * to the instantaneous frequencies { abs, freq }.
+   **/
+  void analyze(voyx::vector<std::complex<T>> dft)
+  {
+    T* const buffer = analysis.buffer.data();
+    T* const delta = analysis.delta.data();
+    T* const data = reinterpret_cast<T*>(dft.data());
+
+    for (size_t i = 0; i < dft.size(); ++i)
+    {
+      const T phase = data[i * 2 + 1];
+
+      delta[i] = phase - buffer[i] - i * phaseinc;
+      buffer[i] = phase;
+    }
+
+    // the bins are independent, so wrap them all at once
+    SIMD::wrap(dft.size(), delta);
+
+    for (size_t i = 0; i < dft.size(); ++i)
+    {
+      const T j = delta[i] / phaseinc;
+
+      data[i * 2 + 1] = (i + j) * freqinc;
+    }
+  }
+
+  /**
+   * Converts the instantaneous frequencies { abs, freq }
+   * to the accumulated phase values { abs, arg }.
+   **/
+  void synthesize(voyx::vector<std::complex<T>> dft)
+  {
+    T* const buffer = synthesis.buffer.data();
+    const T* const timeshift = synthesis.timeshift.data();
+    T* const data = reinterpret_cast<T*>(dft.data());
+
+    for (size_t i = 0; i < dft.size(); ++i)
+    {
+      const T frequency = data[i * 2 + 1];
+      const T j = (frequency - i * freqinc) / freqinc;
+      const T delta = (i + j) * phaseinc;
+
+      buffer[i] += delta;
+
+      data[i * 2 + 1] = buffer[i] - timeshift[i];
+    }
+
+    // keep the accumulated phase bounded, which otherwise loses precision over time
+    SIMD::wrap(dft.size(), buffer);
+  }
+
   /**
    * Converts the specified arbitrary phase value
    * to be within the interval from -pi to pi.
@@ -0,0 +1,81 @@
+#include <voyx/dsp/AsyncGraphPipeline.h>
+
+#include <voyx/Source.h>
+
+AsyncGraphPipeline::AsyncGraphPipeline(const double samplerate, const size_t framesize, const size_t hopsize, const size_t dftsize,
+                                       Factory factory,
+                                       std::shared_ptr<Source<sample_t>> source, std::shared_ptr<Sink<sample_t>> sink,
+                                       const size_t workers) :
+  AsyncPipeline(source, sink, workers),
+  analysis(framesize, hopsize, dftsize, source->framesize()),
+  synthesis(framesize, hopsize, dftsize, source->framesize()),
+  vocoder(samplerate, framesize, hopsize, dftsize)
+{
+  for (size_t slot = 0; slot < slots(); ++slot)
+  {
+    effects.push_back(factory());
+
+    for (auto& effect : effects.back())
+    {
+      effect->reserve(analysis.hops().size());
+    }
+  }
+
+  data.dfts.resize(slots() * analysis.hops().size() * analysis.size());
+
+  stage("analysis", true, [this](const size_t index, const size_t slot) { analyze(index, slot); });
+  stage("effects", false, [this](const size_t index, const size_t slot) { process(index, slot); });
+  stage("synthesis", true, [this](const size_t index, const size_t slot) { synthesize(index, slot); });
+}
+
+size_t AsyncGraphPipeline::latency() const
+{
+  return analysis.latency();
+}
+
+voyx::matrix<phasor_t> AsyncGraphPipeline::dfts(const size_t slot)
+{
+  const size_t size = analysis.hops().size() * analysis.size();
+
+  return voyx::matrix<phasor_t>(data.dfts.data() + slot * size, size, analysis.size());
+}
+
+void AsyncGraphPipeline::analyze(const size_t index, const size_t slot)
+{
+  auto dfts = this->dfts(slot);
+
+  {
+    VOYXZONE("stft");
+    analysis.stft(input(slot), dfts);
+  }
+
+  {
+    VOYXZONE("encode");
+    vocoder.encode(dfts);
+  }
+}
+
+void AsyncGraphPipeline::process(const size_t index, const size_t slot)
+{
+  auto dfts = this->dfts(slot);
+
+  for (auto& effect : effects[slot])
+  {
+    (*effect)(index, dfts);
+  }
+}
+
+void AsyncGraphPipeline::synthesize(const size_t index, const size_t slot)
+{
+  auto dfts = this->dfts(slot);
+
+  {
+    VOYXZONE("decode");
+    vocoder.decode(dfts);
+  }
+
+  {
+    VOYXZONE("istft");
+    synthesis.istft(dfts, output(slot));
+  }
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <voyx/Header.h>
+#include <voyx/alg/STFT.h>
+#include <voyx/alg/Vocoder.h>
+#include <voyx/dsp/AsyncPipeline.h>
+#include <voyx/fx/Effect.h>
+
+/**
+ * Asynchronous counterpart of the GraphPipeline.
+ *
+ * The STFT analysis with the vocoder encoding as well as the vocoder decoding
+ * with the STFT synthesis are stateful and thus run as serial stages,
+ * while the effect chain runs as a parallel stage in between.
+ * Therefore each slot gets its own instance of the effect chain.
+ **/
+class AsyncGraphPipeline : public AsyncPipeline<sample_t>
+{
+
+public:
+
+  typedef std::function<std::vector<std::shared_ptr<Effect>>()> Factory;
+
+  AsyncGraphPipeline(const double samplerate, const size_t framesize, const size_t hopsize, const size_t dftsize,
+                     Factory factory,
+                     std::shared_ptr<Source<sample_t>> source, std::shared_ptr<Sink<sample_t>> sink,
+                     const size_t workers = 0);
+
+  size_t latency() const override;
+
+private:
+
+  // separate instances, since the analysis and synthesis stages run concurrently
+  STFT<sample_t, phasor_t::value_type> analysis;
+  STFT<sample_t, phasor_t::value_type> synthesis;
+
+  Vocoder<phasor_t::value_type> vocoder;
+
+  std::vector<std::vector<std::shared_ptr<Effect>>> effects;
+
+  struct
+  {
+    std::vector<phasor_t> dfts;
+  }
+  data;
+
+  voyx::matrix<phasor_t> dfts(const size_t slot);
+
+  void analyze(const size_t index, const size_t slot);
+  void process(const size_t index, const size_t slot);
+  void synthesize(const size_t index, const size_t slot);
+
+};
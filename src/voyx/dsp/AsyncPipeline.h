@@ -1,32 +1,117 @@
 #pragma once
 
 #include <voyx/Header.h>
+#include <voyx/etc/Heap.h>
 #include <voyx/etc/Logger.h>
+#include <voyx/etc/Profiler.h>
+#include <voyx/etc/Realtime.h>
 #include <voyx/etc/Timer.h>
 #include <voyx/dsp/Pipeline.h>
 
+/**
+ * Multi-stage, multi-worker pipeline executor.
+ *
+ * Each frame occupies one of the preallocated slots while passing through the registered stages.
+ * Serial stages process one frame after another in index order on a dedicated thread,
+ * e.g. because they carry state from frame to frame like the STFT or the vocoder,
+ * while parallel stages process independent frames concurrently on all workers.
+ * So the analysis of frame N+1 overlaps with the synthesis of frame N
+ * and with the processing of other frames in between.
+ *
+ * The output frames are reassembled in index order before being written to the sink.
+ **/
 template<typename T = sample_t>
 class AsyncPipeline : public Pipeline<T>
 {
 
 public:
 
-  AsyncPipeline(std::shared_ptr<Source<T>> source, std::shared_ptr<Sink<T>> sink) :
-    Pipeline<T>(source, sink)
+  typedef std::function<void(const size_t index, const size_t slot)> Callback;
+
+  AsyncPipeline(std::shared_ptr<Source<T>> source, std::shared_ptr<Sink<T>> sink, const size_t workers = 0) :
+    Pipeline<T>(source, sink),
+    workers(workers ? workers : std::max<size_t>(std::thread::hardware_concurrency(), 1))
+  {
+    // enough frames in flight to keep all workers
+    // as well as the serial stages before and after them busy
+    data.slots.resize(this->workers * 2 + 2);
+
+    for (auto& slot : data.slots)
+    {
+      slot.input.resize(source->framesize());
+      slot.output.resize(sink->framesize());
+    }
+  }
+
+  /**
+   * Returns the number of frames in flight, which is also
+   * the number of per-frame workspaces required by the stages.
+   **/
+  size_t slots() const
   {
+    return data.slots.size();
   }
 
 protected:
 
+  const size_t workers;
+
+  /**
+   * Appends a stage, which is invoked once per frame with the frame index
+   * and the slot which holds the frame data until it has been written to the sink.
+   **/
+  void stage(const std::string& name, const bool serial, Callback callback)
+  {
+    auto stage = std::make_shared<Stage>();
+
+    stage->name = name;
+    stage->serial = serial;
+    stage->callback = callback;
+
+    stages.push_back(stage);
+  }
+
+  voyx::vector<T> input(const size_t slot)
+  {
+    return data.slots[slot].input;
+  }
+
+  voyx::vector<T> output(const size_t slot)
+  {
+    return data.slots[slot].output;
+  }
+
   void onstart(const size_t frames, const std::chrono::duration<double> timeout) override
   {
-    timers.read.cls();
-    timers.write.cls();
+    voyxassert(!stages.empty());
+
+    // the output must be delivered at least once per frame period
+    const auto period = std::chrono::duration<double>(
+      this->source->framesize() / this->source->samplerate());
+
+    for (Timers* each : { &timers, &totals })
+    {
+      each->read.cls();
+      each->write.cls();
+      each->write.deadline(period);
+    }
+
+    for (auto& stage : stages)
+    {
+      // parallel stages may take as many frame periods as there are workers
+      const auto deadline = stage->serial ? period : period * workers;
+
+      for (auto* each : { &stage->timer, &stage->total })
+      {
+        each->cls();
+        each->deadline(deadline);
+      }
+    }
 
     doloop = true;
 
     thread = std::make_shared<std::thread>(
-      [frames, this](){ loop(frames, timeout); });
+      [frames, timeout, this](){ loop(frames, timeout); });
 
     if (frames > 0)
     {
@@ -39,7 +124,12 @@ protected:
 
   void onstop() override
   {
-    doloop = false;
+    {
+      std::lock_guard lock(mutex);
+      doloop = false;
+    }
+
+    condition.notify_all();
 
     if (thread != nullptr)
     {
@@ -52,31 +142,400 @@ protected:
     }
   }
 
-  virtual void begin(const size_t index, const voyx::vector<T> input) = 0;
+private:
 
-  void end(const size_t index, const voyx::vector<T> output)
+  static constexpr size_t npos = size_t(-1);
+
+  struct Slot
   {
-    timers.write.toc();
-    timers.write.tic();
+    size_t index = 0;
+    size_t stage = 0;
+    bool free = true;
+    bool busy = false;
 
-    this->sink->sync();
-    this->sink->write(index, output);
-  }
+    std::vector<T> input;
+    std::vector<T> output;
+  };
 
-private:
+  struct Stage
+  {
+    std::string name;
+    bool serial;
+    Callback callback;
 
-  struct
+    size_t next = 0;
+
+    Timer<std::chrono::milliseconds> timer;
+    Timer<std::chrono::milliseconds> total;
+  };
+
+  struct Timers
   {
     Timer<std::chrono::milliseconds> read;
     Timer<std::chrono::milliseconds> write;
-  }
-  timers;
+  };
+
+  Timers timers;
+  Timers totals;
+
+  std::vector<std::shared_ptr<Stage>> stages;
 
   std::shared_ptr<std::thread> thread;
+  std::vector<std::thread> threads;
+
   bool doloop = false;
+  bool running = false;
+
+  std::mutex mutex;
+  std::condition_variable condition;
+
+  struct
+  {
+    std::vector<Slot> slots;
+  }
+  data;
+
+  std::vector<std::pair<std::string, const Timer<std::chrono::milliseconds>*>> statistics() const override
+  {
+    std::vector<std::pair<std::string, const Timer<std::chrono::milliseconds>*>> statistics =
+    {
+      { "read", &totals.read },
+      { "write", &totals.write }
+    };
+
+    for (const auto& stage : stages)
+    {
+      statistics.emplace_back(stage->name, &stage->total);
+    }
+
+    return statistics;
+  }
+
+  /**
+   * Logs the timings since the last report
+   * and accumulates them for the final statistics.
+   *
+   * Since the workers and the writer keep recording meanwhile,
+   * each timer is drained into a snapshot instead of being merged and cleared.
+   **/
+  void report()
+  {
+    std::ostringstream stagetimers;
+
+    for (auto& stage : stages)
+    {
+      Timer<std::chrono::milliseconds> snapshot;
+
+      stage->timer.drain(snapshot);
+      stagetimers << "\t" << stage->name << " " << snapshot.str();
+      stage->total.merge(snapshot);
+    }
+
+    Timers snapshot;
+
+    timers.read.drain(snapshot.read);
+    timers.write.drain(snapshot.write);
+
+    LOG(INFO)
+      << "Timing: \t"
+      << "read  " << snapshot.read.str() << "\t"
+      << "write " << snapshot.write.str()
+      << stagetimers.str();
+
+    totals.read.merge(snapshot.read);
+    totals.write.merge(snapshot.write);
+  }
+
+  /**
+   * Waits for a free slot to read the next frame into,
+   * returns npos if the pipeline is being stopped.
+   **/
+  size_t lease()
+  {
+    std::unique_lock lock(mutex);
+
+    size_t result = npos;
+
+    condition.wait(lock, [&]()
+    {
+      if (!doloop)
+      {
+        return true;
+      }
+
+      for (size_t i = 0; i < data.slots.size(); ++i)
+      {
+        if (data.slots[i].free)
+        {
+          result = i;
+          return true;
+        }
+      }
+
+      return false;
+    });
+
+    if (result != npos)
+    {
+      data.slots[result].free = false;
+      data.slots[result].busy = true;
+    }
+
+    return result;
+  }
+
+  /**
+   * Waits for a frame which is ready for the specified stage
+   * and also the next one in index order in case of a serial stage,
+   * returns npos if the pipeline is being stopped.
+   **/
+  size_t acquire(const size_t stage, const bool serial, const size_t next)
+  {
+    std::unique_lock lock(mutex);
+
+    size_t result = npos;
+
+    condition.wait(lock, [&]()
+    {
+      if (!running)
+      {
+        return true;
+      }
+
+      for (size_t i = 0; i < data.slots.size(); ++i)
+      {
+        const auto& slot = data.slots[i];
+
+        if (!slot.free && !slot.busy && slot.stage == stage && (!serial || slot.index == next))
+        {
+          result = i;
+          return true;
+        }
+      }
+
+      return false;
+    });
+
+    if (result != npos)
+    {
+      data.slots[result].busy = true;
+    }
+
+    return result;
+  }
+
+  /**
+   * Passes the frame on to the next stage.
+   **/
+  void advance(const size_t slot)
+  {
+    {
+      std::lock_guard lock(mutex);
+
+      data.slots[slot].stage++;
+      data.slots[slot].busy = false;
+    }
+
+    condition.notify_all();
+  }
+
+  /**
+   * Returns the slot to the reader.
+   **/
+  void release(const size_t slot)
+  {
+    {
+      std::lock_guard lock(mutex);
+
+      data.slots[slot].stage = 0;
+      data.slots[slot].free = true;
+      data.slots[slot].busy = false;
+    }
+
+    condition.notify_all();
+  }
+
+  /**
+   * Waits until all frames in flight have been written to the sink.
+   **/
+  void drain()
+  {
+    std::unique_lock lock(mutex);
+
+    condition.wait(lock, [&]()
+    {
+      return !doloop || std::all_of(data.slots.begin(), data.slots.end(),
+        [](const Slot& slot) { return slot.free; });
+    });
+  }
+
+  bool read(const size_t index)
+  {
+    const size_t slot = lease();
+
+    if (slot == npos)
+    {
+      return false;
+    }
+
+    const bool ok = this->pad(index, [&](const voyx::vector<T> input)
+    {
+      timers.read.toc();
+      timers.read.tic();
+
+      std::copy(input.begin(), input.end(), data.slots[slot].input.begin());
+    });
+
+    if (!ok)
+    {
+      release(slot);
+
+      return false;
+    }
+
+    {
+      std::lock_guard lock(mutex);
+
+      data.slots[slot].index = index;
+      data.slots[slot].busy = false;
+    }
+
+    condition.notify_all();
+
+    return true;
+  }
+
+  void process(Stage& stage, const size_t number, const size_t core)
+  {
+    Realtime::promote("async pipeline " + stage.name, core);
+
+    while (true)
+    {
+      const size_t slot = acquire(number, stage.serial, stage.next);
+
+      if (slot == npos)
+      {
+        break;
+      }
+
+      const size_t index = data.slots[slot].index;
+
+      if (stage.serial)
+      {
+        stage.next++;
+      }
+
+      const auto timestamp = std::chrono::steady_clock::now();
+
+      {
+        Heap::Realtime realtime;
+        stage.callback(index, slot);
+      }
+
+      stage.timer.add(std::chrono::steady_clock::now() - timestamp);
+
+      advance(slot);
+    }
+  }
+
+  void write()
+  {
+    Realtime::promote("async pipeline write", 1);
+
+    size_t next = 0;
+
+    while (true)
+    {
+      const size_t slot = acquire(stages.size(), true, next);
+
+      if (slot == npos)
+      {
+        break;
+      }
+
+      const size_t index = data.slots[slot].index;
+
+      next++;
+
+      timers.write.toc();
+      timers.write.tic();
+
+      if (this->offline)
+      {
+        this->trim(index, [&](voyx::vector<T> output)
+        {
+          std::copy(data.slots[slot].output.begin(), data.slots[slot].output.end(), output.begin());
+        });
+      }
+      else
+      {
+        this->sink->sync();
+        this->sink->write(index, data.slots[slot].output);
+      }
+
+      release(slot);
+    }
+  }
+
+  void spawn()
+  {
+    for (auto& slot : data.slots)
+    {
+      slot.index = 0;
+      slot.stage = 0;
+      slot.free = true;
+      slot.busy = false;
+    }
+
+    running = true;
+
+    // the reader and the writer occupy the first two cores,
+    // so that all stage workers run on distinct cores after them
+    size_t core = 2;
+
+    for (size_t number = 0; number < stages.size(); ++number)
+    {
+      auto& stage = *stages[number];
+
+      stage.next = 0;
+
+      for (size_t i = 0; i < (stage.serial ? 1 : workers); ++i)
+      {
+        threads.emplace_back([&stage, number, core, this]() { process(stage, number, core); });
+
+        core++;
+      }
+    }
+
+    threads.emplace_back([this]() { write(); });
+  }
+
+  void join()
+  {
+    {
+      std::lock_guard lock(mutex);
+      running = false;
+    }
+
+    condition.notify_all();
+
+    for (auto& thread : threads)
+    {
+      if (thread.joinable())
+      {
+        thread.join();
+      }
+    }
+
+    threads.clear();
+  }
 
   void loop(const size_t frames, const std::chrono::duration<double> timeout)
   {
+    Realtime::promote("async pipeline", 0);
+
+    spawn();
+
     size_t index = 0;
     bool ok = true;
 
@@ -85,28 +544,30 @@ private:
 
     if (frames > 0)
     {
-      while (doloop && index < frames)
-      {
-        ok = this->source->read(index, [&](const voyx::vector<T> input)
-        {
-          timers.read.toc();
-          timers.read.tic();
+      const auto timestamp = std::chrono::steady_clock::now();
 
-          begin(index, input);
-        });
+      // an offline render neither waits for the sink nor sleeps,
+      // but flushes the latency through additional silent frames
+      const size_t total = frames + this->lookahead();
+
+      while (doloop && index < total)
+      {
+        ok = read(index);
 
         index += ok ? 1 : 0;
 
-        if (timeout != std::chrono::duration<double>::zero())
+        if (!this->offline && timeout != std::chrono::duration<double>::zero())
         {
           std::this_thread::sleep_for(timeout);
         }
       }
 
-      LOG(INFO)
-        << "Timing: \t"
-        << "read  " << timers.read.str() << "\t"
-        << "write " << timers.write.str();
+      drain();
+      join();
+      report();
+
+      Pipeline<T>::throughput(std::min(index, frames),
+        this->source->framesize(), this->source->samplerate(), timestamp);
     }
     else
     {
@@ -126,24 +587,12 @@ private:
       {
         if (millis(now() - timestamp) > 5000)
         {
-          LOG(INFO)
-            << "Timing: \t"
-            << "read  " << timers.read.str() << "\t"
-            << "write " << timers.write.str();
-
-          timers.read.cls();
-          timers.write.cls();
+          report();
 
           timestamp = now();
         }
 
-        ok = this->source->read(index, [&](const voyx::vector<T> input)
-        {
-          timers.read.toc();
-          timers.read.tic();
-
-          begin(index, input);
-        });
+        ok = read(index);
 
         index += ok ? 1 : 0;
 
@@ -152,6 +601,9 @@ private:
           std::this_thread::sleep_for(timeout);
         }
       }
+
+      join();
+      report();
     }
   }
 
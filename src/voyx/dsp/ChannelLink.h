@@ -0,0 +1,43 @@
+#pragma once
+
+#include <voyx/Header.h>
+
+/**
+ * Shares the spectral envelope of the first channel of a linked MultichannelPipeline
+ * with the other channels, so that it is estimated only once per frame.
+ *
+ * The first channel is processed ahead of the other channels,
+ * which therefore always reuse the envelope of the current frame.
+ **/
+class ChannelLink
+{
+
+public:
+
+  ChannelLink(const size_t dftsize)
+  {
+    data.envelope.resize(dftsize);
+  }
+
+  /**
+   * Returns true if the specified channel estimates the shared analysis.
+   **/
+  static bool leader(const size_t channel)
+  {
+    return channel == 0;
+  }
+
+  voyx::vector<phasor_t::value_type> envelope()
+  {
+    return data.envelope;
+  }
+
+private:
+
+  struct
+  {
+    std::vector<phasor_t::value_type> envelope;
+  }
+  data;
+
+};
@@ -0,0 +1,370 @@
+#include <voyx/dsp/DeadlineScheduler.h>
+
+#include <voyx/Source.h>
+#include <voyx/etc/Realtime.h>
+
+DeadlineScheduler::DeadlineScheduler(const size_t threads)
+{
+  for (size_t i = 0; i < std::max(threads, size_t(1)); ++i)
+  {
+    workers.push_back(std::make_unique<Worker>());
+  }
+}
+
+DeadlineScheduler::~DeadlineScheduler()
+{
+  stop();
+}
+
+size_t DeadlineScheduler::threads() const
+{
+  return workers.size();
+}
+
+size_t DeadlineScheduler::size() const
+{
+  std::lock_guard lock(mutex);
+
+  return streams;
+}
+
+size_t DeadlineScheduler::add(const std::chrono::duration<double> period, Task task)
+{
+  auto stream = std::make_shared<Stream>();
+
+  stream->index = 0;
+  stream->period = std::chrono::duration_cast<clock::duration>(period);
+  stream->task = task;
+
+  bool running = false;
+
+  {
+    std::lock_guard lock(mutex);
+
+    stream->id = ids++;
+    streams++;
+
+    running = doloop;
+
+    if (!running)
+    {
+      idle.push_back(stream);
+    }
+  }
+
+  if (running)
+  {
+    resume(stream);
+  }
+
+  return stream->id;
+}
+
+void DeadlineScheduler::start(const bool paced)
+{
+  stop();
+
+  std::vector<std::shared_ptr<Stream>> streams;
+
+  {
+    std::lock_guard lock(mutex);
+
+    this->paced = paced;
+    doloop = true;
+
+    streams.swap(idle);
+  }
+
+  for (size_t i = 0; i < workers.size(); ++i)
+  {
+    workers[i]->thread = std::thread([this, i]() { work(i); });
+  }
+
+  dispatcher = std::thread([this]() { dispatch(); });
+
+  for (auto& stream : streams)
+  {
+    resume(stream);
+  }
+}
+
+void DeadlineScheduler::stop()
+{
+  {
+    std::lock_guard lock(mutex);
+
+    doloop = false;
+  }
+
+  ready.notify_all();
+  pending.notify_all();
+
+  for (auto& worker : workers)
+  {
+    if (worker->thread.joinable())
+    {
+      worker->thread.join();
+    }
+  }
+
+  if (dispatcher.joinable())
+  {
+    dispatcher.join();
+  }
+
+  // keep the unfinished streams for the next start
+
+  std::lock_guard lock(mutex);
+
+  auto suspend = [&](std::vector<Job>& jobs)
+  {
+    for (auto& job : jobs)
+    {
+      job.stream->index = job.index;
+      idle.push_back(job.stream);
+    }
+
+    jobs.clear();
+  };
+
+  for (auto& worker : workers)
+  {
+    std::lock_guard lock(worker->mutex);
+
+    suspend(worker->queue);
+  }
+
+  suspend(releases);
+
+  queued = 0;
+}
+
+void DeadlineScheduler::wait()
+{
+  std::unique_lock lock(mutex);
+
+  ended.wait(lock, [&]()
+  {
+    return streams == 0;
+  });
+}
+
+bool DeadlineScheduler::bydeadline(const Job& a, const Job& b)
+{
+  return a.deadline > b.deadline;
+}
+
+bool DeadlineScheduler::byrelease(const Job& a, const Job& b)
+{
+  return a.release > b.release;
+}
+
+void DeadlineScheduler::resume(std::shared_ptr<Stream> stream)
+{
+  const auto now = clock::now();
+
+  // the frame of the current index arrives right now
+  stream->origin = now - stream->period * static_cast<clock::rep>(stream->index);
+
+  schedule({ stream, stream->index, now, now + stream->period });
+}
+
+void DeadlineScheduler::schedule(Job job)
+{
+  {
+    std::lock_guard lock(mutex);
+
+    // once stopping, keep the job for the next start
+    if (!doloop)
+    {
+      job.stream->index = job.index;
+      idle.push_back(job.stream);
+      return;
+    }
+
+    if (paced && job.release > clock::now())
+    {
+      releases.push_back(job);
+      std::push_heap(releases.begin(), releases.end(), byrelease);
+
+      pending.notify_one();
+      return;
+    }
+  }
+
+  enqueue(job);
+}
+
+void DeadlineScheduler::enqueue(Job job)
+{
+  // each stream prefers the same worker, which keeps its data in the same cache
+  Worker& worker = *workers[job.stream->id % workers.size()];
+
+  {
+    // count the job only together with the push,
+    // so that each claimed job is already queued
+    std::lock_guard lock(mutex);
+    std::lock_guard push(worker.mutex);
+
+    worker.queue.push_back(job);
+    std::push_heap(worker.queue.begin(), worker.queue.end(), bydeadline);
+
+    queued++;
+  }
+
+  ready.notify_one();
+}
+
+bool DeadlineScheduler::dequeue(const size_t worker, Job& job)
+{
+  auto pop = [&](Worker& victim)
+  {
+    std::lock_guard lock(victim.mutex);
+
+    if (victim.queue.empty())
+    {
+      return false;
+    }
+
+    std::pop_heap(victim.queue.begin(), victim.queue.end(), bydeadline);
+    job = victim.queue.back();
+    victim.queue.pop_back();
+
+    return true;
+  };
+
+  if (pop(*workers[worker]))
+  {
+    return true;
+  }
+
+  // otherwise steal the most urgent task of all other workers
+
+  std::optional<size_t> victim;
+  clock::time_point deadline = clock::time_point::max();
+
+  for (size_t i = 0; i < workers.size(); ++i)
+  {
+    if (i == worker)
+    {
+      continue;
+    }
+
+    std::lock_guard lock(workers[i]->mutex);
+
+    if (!workers[i]->queue.empty() && workers[i]->queue.front().deadline < deadline)
+    {
+      deadline = workers[i]->queue.front().deadline;
+      victim = i;
+    }
+  }
+
+  return victim && pop(*workers[victim.value()]);
+}
+
+void DeadlineScheduler::dispatch()
+{
+  std::unique_lock lock(mutex);
+
+  while (doloop)
+  {
+    if (releases.empty())
+    {
+      pending.wait(lock);
+      continue;
+    }
+
+    const auto release = releases.front().release;
+
+    if (clock::now() < release)
+    {
+      pending.wait_until(lock, release);
+      continue;
+    }
+
+    std::pop_heap(releases.begin(), releases.end(), byrelease);
+    Job job = releases.back();
+    releases.pop_back();
+
+    lock.unlock();
+    enqueue(job);
+    lock.lock();
+  }
+}
+
+void DeadlineScheduler::work(const size_t worker)
+{
+  Realtime::promote($("scheduler worker {0}", worker), worker);
+
+  while (true)
+  {
+    {
+      std::unique_lock lock(mutex);
+
+      // an overloaded stream always has another job queued,
+      // so check for stop before each job and not only when idle
+      ready.wait(lock, [&]()
+      {
+        return !doloop || queued > 0;
+      });
+
+      if (!doloop)
+      {
+        break;
+      }
+
+      // claim one of the queued jobs, so that no other worker is woken for it
+      queued--;
+    }
+
+    Job job;
+
+    // the claimed job is in one of the queues, but may be stolen
+    // by another worker between finding and popping the most urgent one
+    while (!dequeue(worker, job))
+    {
+      std::this_thread::yield();
+    }
+
+    run(job);
+  }
+}
+
+void DeadlineScheduler::run(Job& job)
+{
+  auto& stream = *job.stream;
+
+  bool alive = false;
+
+  try
+  {
+    alive = stream.task(job.index, job.deadline);
+  }
+  catch (const std::exception& exception)
+  {
+    LOG(ERROR) << $("Stream {0} failed: {1}", stream.id, exception.what());
+  }
+
+  if (!alive)
+  {
+    {
+      std::lock_guard lock(mutex);
+
+      streams--;
+    }
+
+    ended.notify_all();
+
+    return;
+  }
+
+  const size_t index = job.index + 1;
+
+  schedule(
+  {
+    job.stream,
+    index,
+    stream.origin + stream.period * static_cast<clock::rep>(index),
+    stream.origin + stream.period * static_cast<clock::rep>(index + 1)
+  });
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <voyx/Header.h>
+
+/**
+ * Earliest deadline first scheduler for many periodic real-time streams.
+ *
+ * Each stream releases one task per period, i.e. at the nominal arrival time of its next frame,
+ * which has to be completed before the arrival of the following frame. The next task of a stream
+ * is not released before the previous one has been completed, so the tasks of the same stream
+ * never run concurrently and the stream state needs no synchronization.
+ *
+ * Released tasks are queued by deadline per worker. Each worker runs the most urgent task
+ * of its own queue and otherwise steals the most urgent task of all other queues.
+ **/
+class DeadlineScheduler
+{
+
+public:
+
+  typedef std::chrono::steady_clock clock;
+
+  /**
+   * Processes the frame of the specified index until the specified deadline
+   * and returns false if the stream has ended.
+   **/
+  typedef std::function<bool(const size_t index, const clock::time_point deadline)> Task;
+
+  DeadlineScheduler(const size_t threads = std::thread::hardware_concurrency());
+  ~DeadlineScheduler();
+
+  size_t threads() const;
+
+  /**
+   * Returns the number of streams which have not ended yet.
+   **/
+  size_t size() const;
+
+  /**
+   * Adds a stream with the specified frame period, which is released
+   * immediately if already started, otherwise as soon as started.
+   * Returns the stream id.
+   **/
+  size_t add(const std::chrono::duration<double> period, Task task);
+
+  /**
+   * Starts the workers. If not paced, the next task of a stream is released
+   * as soon as the previous one has been completed, e.g. for offline rendering.
+   **/
+  void start(const bool paced = true);
+  void stop();
+
+  /**
+   * Blocks until all streams have ended.
+   **/
+  void wait();
+
+private:
+
+  struct Stream
+  {
+    size_t id;
+    size_t index; // next frame after a restart
+    clock::duration period;
+    clock::time_point origin;
+    Task task;
+  };
+
+  struct Job
+  {
+    std::shared_ptr<Stream> stream;
+    size_t index;
+    clock::time_point release;
+    clock::time_point deadline;
+  };
+
+  struct Worker
+  {
+    std::mutex mutex;
+    std::vector<Job> queue; // min heap by deadline
+    std::thread thread;
+  };
+
+  std::vector<std::unique_ptr<Worker>> workers;
+
+  bool paced = true;
+  bool doloop = false;
+
+  size_t ids = 0;
+  size_t streams = 0;
+  size_t queued = 0; // released but not yet claimed jobs
+
+  std::vector<std::shared_ptr<Stream>> idle; // added before start
+  std::vector<Job> releases;                 // min heap by release time
+  std::thread dispatcher;
+
+  mutable std::mutex mutex;
+  std::condition_variable ready;
+  std::condition_variable pending;
+  std::condition_variable ended;
+
+  static bool bydeadline(const Job& a, const Job& b);
+  static bool byrelease(const Job& a, const Job& b);
+
+  void resume(std::shared_ptr<Stream> stream);
+  void schedule(Job job);
+  void enqueue(Job job);
+  bool dequeue(const size_t worker, Job& job);
+
+  void dispatch();
+  void work(const size_t worker);
+  void run(Job& job);
+
+};
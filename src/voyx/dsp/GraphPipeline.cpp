@@ -0,0 +1,46 @@
+#include <voyx/dsp/GraphPipeline.h>
+
+#include <voyx/Source.h>
+
+GraphPipeline::GraphPipeline(const double samplerate, const size_t framesize, const size_t hopsize, const size_t dftsize,
+                             const std::vector<std::shared_ptr<Effect>>& effects,
+                             std::shared_ptr<Source<sample_t>> source, std::shared_ptr<Sink<sample_t>> sink) :
+  StftPipeline(samplerate, framesize, hopsize, dftsize, source, sink),
+  vocoder(samplerate, framesize, hopsize, dftsize),
+  effects(effects)
+{
+  for (auto& effect : effects)
+  {
+    effect->reserve(hops());
+  }
+}
+
+void GraphPipeline::parallelize(std::shared_ptr<ThreadPool> pool)
+{
+  StftPipeline::parallelize(pool);
+
+  for (auto& effect : effects)
+  {
+    effect->parallelize(pool);
+  }
+}
+
+void GraphPipeline::operator()(const size_t index,
+                               const voyx::vector<sample_t> signal,
+                               voyx::matrix<phasor_t> dfts)
+{
+  {
+    VOYXZONE("encode");
+    vocoder.encode(dfts);
+  }
+
+  for (auto& effect : effects)
+  {
+    (*effect)(index, dfts);
+  }
+
+  {
+    VOYXZONE("decode");
+    vocoder.decode(dfts);
+  }
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <voyx/Header.h>
+#include <voyx/alg/Vocoder.h>
+#include <voyx/dsp/StftPipeline.h>
+#include <voyx/fx/Effect.h>
+
+/**
+ * Applies a chain of spectral effects in series, sharing a single STFT analysis and synthesis
+ * as well as a single vocoder encode and decode step per frame.
+ *
+ * Nested graphs are built by effects wrapping other effects, e.g. the FormantEffect.
+ **/
+class GraphPipeline : public StftPipeline<>
+{
+
+public:
+
+  GraphPipeline(const double samplerate, const size_t framesize, const size_t hopsize, const size_t dftsize,
+                const std::vector<std::shared_ptr<Effect>>& effects,
+                std::shared_ptr<Source<sample_t>> source, std::shared_ptr<Sink<sample_t>> sink);
+
+  void parallelize(std::shared_ptr<ThreadPool> pool) override;
+
+  void operator()(const size_t index,
+                  const voyx::vector<sample_t> signal,
+                  voyx::matrix<phasor_t> dfts) override;
+
+private:
+
+  Vocoder<phasor_t::value_type> vocoder;
+
+  const std::vector<std::shared_ptr<Effect>> effects;
+
+};
@@ -21,6 +21,9 @@ InverseSynthPipeline::InverseSynthPipeline(const double samplerate, const size_t
     midikeys = $$::midi::keys<double>();
     midibins = $$::interp(midikeys, dftkeys, dftbins);
     dftfreqs = $$::interp(dftbins, midibins, midifreqs);
+
+    midimask.resize(midikeys.size());
+    dftmask.resize(dftbins.size());
   }
 
   if (plot != nullptr)
@@ -37,11 +40,17 @@ void InverseSynthPipeline::operator()(const size_t index,
 {
   if (midi != nullptr)
   {
-    for (auto dft : dfts)
+    midi->snapshot(midistate);
+
+    for (size_t i = 0; i < midimask.size(); ++i)
     {
-      const auto midimask = midi->mask();
-      const auto dftmask = $$::interp(dftbins, midibins, midimask);
+      midimask[i] = midistate.velocities[i] / 127.0;
+    }
 
+    $$::interp<double>(dftbins, dftmask, midibins, midimask);
+
+    for (auto dft : dfts)
+    {
       for (size_t i = 0; i < dft.size(); ++i)
       {
         dft[i].real(dftmask[i]);
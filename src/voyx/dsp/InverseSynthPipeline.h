@@ -21,7 +21,7 @@ public:
 
 private:
 
-  Vocoder<double> vocoder;
+  Vocoder<phasor_t::value_type> vocoder;
 
   std::shared_ptr<MidiObserver> midi;
   std::shared_ptr<Plot> plot;
@@ -29,4 +29,7 @@ private:
   std::vector<double> dftbins, dftfreqs, dftkeys;
   std::vector<double> midibins, midifreqs, midikeys;
 
+  MidiObserver::Snapshot midistate;
+  std::vector<double> midimask, dftmask;
+
 };
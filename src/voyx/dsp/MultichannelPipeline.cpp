@@ -0,0 +1,68 @@
+#include <voyx/dsp/MultichannelPipeline.h>
+
+#include <voyx/Source.h>
+#include <voyx/io/NullSink.h>
+#include <voyx/io/NullSource.h>
+
+MultichannelPipeline::MultichannelPipeline(Factory factory, const bool linked,
+                                           std::shared_ptr<Source<sample_t>> source, std::shared_ptr<Sink<sample_t>> sink,
+                                           const size_t threads) :
+  SyncPipeline(source, sink),
+  channels(source->channels()),
+  linked(linked),
+  pool(threads ? std::min(threads, source->channels()) : source->channels())
+{
+  voyxassert(source->framesize() == sink->framesize());
+
+  if (source->channels() != sink->channels())
+  {
+    throw std::runtime_error(
+      $("Mismatching number of source and sink channels {0} and {1}!",
+        source->channels(), sink->channels()));
+  }
+
+  for (size_t channel = 0; channel < channels; ++channel)
+  {
+    // the channel pipelines are never started, so their source and sink
+    // only provide the frame parameters, while the frames are passed by process()
+    auto pipeline = std::dynamic_pointer_cast<SyncPipeline<sample_t>>(factory(channel,
+      std::make_shared<NullSource>(source->samplerate(), source->framesize(), source->buffersize()),
+      std::make_shared<NullSink>(sink->samplerate(), sink->framesize(), sink->buffersize())));
+
+    if (pipeline == nullptr)
+    {
+      throw std::runtime_error(
+        "Only synchronous pipelines support multichannel processing!");
+    }
+
+    pipelines.push_back(pipeline);
+  }
+}
+
+size_t MultichannelPipeline::latency() const
+{
+  return pipelines.front()->latency();
+}
+
+void MultichannelPipeline::operator()(const size_t index, const voyx::vector<sample_t> input, voyx::vector<sample_t> output)
+{
+  const voyx::matrix<sample_t> inputs(input, source->framesize());
+  voyx::matrix<sample_t> outputs(output, sink->framesize());
+
+  const size_t first = linked ? 1 : 0;
+
+  if (linked)
+  {
+    VOYXZONE("channel.link");
+    pipelines.front()->process(index, inputs[0], outputs[0]);
+  }
+
+  VOYXZONE("channel");
+
+  pool(channels - first, [&](const size_t i)
+  {
+    const size_t channel = i + first;
+
+    pipelines[channel]->process(index, inputs[channel], outputs[channel]);
+  });
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <voyx/Header.h>
+#include <voyx/dsp/SyncPipeline.h>
+#include <voyx/etc/ThreadPool.h>
+
+/**
+ * Processes each channel of a multichannel source by an individual single channel pipeline instance,
+ * all of them in parallel on separate threads, and passes the result to a multichannel sink.
+ * Optionally the number of threads is limited, e.g. to a single one if the pipeline
+ * itself is one of many running in parallel.
+ *
+ * In the linked mode, the first channel is processed ahead of the other channels,
+ * so that they can reuse its analysis via the ChannelLink instead of repeating it.
+ **/
+class MultichannelPipeline : public SyncPipeline<sample_t>
+{
+
+public:
+
+  typedef std::function<std::shared_ptr<Pipeline<sample_t>>(
+    const size_t channel,
+    std::shared_ptr<Source<sample_t>> source,
+    std::shared_ptr<Sink<sample_t>> sink)> Factory;
+
+  MultichannelPipeline(Factory factory, const bool linked,
+                       std::shared_ptr<Source<sample_t>> source, std::shared_ptr<Sink<sample_t>> sink,
+                       const size_t threads = 0);
+
+  size_t latency() const override;
+
+protected:
+
+  void operator()(const size_t index, const voyx::vector<sample_t> input, voyx::vector<sample_t> output) override;
+
+private:
+
+  const size_t channels;
+  const bool linked;
+
+  std::vector<std::shared_ptr<SyncPipeline<sample_t>>> pipelines;
+
+  ThreadPool pool;
+
+};
@@ -0,0 +1,157 @@
+#include <voyx/dsp/ParallelRenderer.h>
+
+#include <voyx/Source.h>
+#include <voyx/io/MemorySink.h>
+#include <voyx/io/MemorySource.h>
+
+ParallelRenderer::ParallelRenderer(Factory factory, const size_t warmup, const size_t crossfade, const size_t threads) :
+  factory(factory),
+  warmup(warmup),
+  crossfade(std::max(crossfade, size_t(1))),
+  pool(threads)
+{
+}
+
+void ParallelRenderer::operator()(std::shared_ptr<Source<sample_t>> source, std::shared_ptr<Sink<sample_t>> sink)
+{
+  const double samplerate = source->samplerate();
+  const size_t framesize = source->framesize();
+  const size_t buffersize = source->buffersize();
+
+  voyxassert(sink->framesize() == framesize);
+
+  source->open();
+  sink->open();
+
+  const size_t frames = source->frames();
+
+  if (!frames)
+  {
+    throw std::runtime_error(
+      "Unable to render an endless source offline!");
+  }
+
+  const auto timestamp = std::chrono::steady_clock::now();
+
+  std::vector<Segment> segments = partition(frames);
+
+  // the input frames from offset on, which are still required by the current or subsequent batches
+  std::vector<sample_t> input;
+  size_t offset = 0;
+
+  // the crossfade output of the previous segment beyond its end
+  std::vector<sample_t> tail;
+
+  for (size_t batch = 0; batch < segments.size(); batch += pool.size())
+  {
+    const size_t count = std::min(pool.size(), segments.size() - batch);
+
+    const size_t first = segments[batch].first;
+    const size_t stop = segments[batch + count - 1].stop;
+
+    // discard the preceding input and read the next one in order,
+    // since the source doesn't support concurrent or random access
+    input.erase(input.begin(), input.begin() + (first - offset) * framesize);
+    offset = first;
+
+    for (size_t index = offset + input.size() / framesize; index < stop; ++index)
+    {
+      const bool ok = source->read(index, [&](const voyx::vector<sample_t> frame)
+      {
+        input.insert(input.end(), frame.begin(), frame.end());
+      });
+
+      voyxassert(ok);
+    }
+
+    pool(count, [&](const size_t index)
+    {
+      Segment& segment = segments[batch + index];
+
+      segment.output.resize((segment.last - segment.first) * framesize);
+
+      // pass the subsequent input frames as well, so that the pipeline
+      // flushes its latency with the actual input instead of silence
+      const voyx::vector<sample_t> src(
+        input.data() + (segment.first - offset) * framesize,
+        (segment.stop - segment.first) * framesize);
+
+      voyx::vector<sample_t> dst(segment.output);
+
+      auto pipe = factory(
+        std::make_shared<MemorySource>(src, samplerate, framesize, buffersize),
+        std::make_shared<MemorySink>(dst, samplerate, framesize, buffersize));
+
+      pipe->open();
+      pipe->start(segment.last - segment.first);
+      pipe->close();
+    });
+
+    for (size_t i = batch; i < batch + count; ++i)
+    {
+      Segment& segment = segments[i];
+
+      sample_t* output = segment.output.data() + (segment.begin - segment.first) * framesize;
+
+      // fade in over the tail of the previous segment
+      const size_t fade = std::min(tail.size(), (segment.end - segment.begin) * framesize);
+
+      for (size_t j = 0; j < fade; ++j)
+      {
+        const sample_t weight = sample_t(0.5) - sample_t(0.5) * std::cos(
+          std::acos(sample_t(-1)) * j / fade);
+
+        output[j] = tail[j] * (1 - weight) + output[j] * weight;
+      }
+
+      for (size_t index = segment.begin; index < segment.end; ++index)
+      {
+        sink->write(index, voyx::vector<sample_t>(output + (index - segment.begin) * framesize, framesize));
+      }
+
+      tail.assign(
+        segment.output.begin() + (segment.end - segment.first) * framesize,
+        segment.output.end());
+
+      segment.output.clear();
+      segment.output.shrink_to_fit();
+    }
+  }
+
+  Pipeline<sample_t>::throughput(frames, framesize, samplerate, timestamp,
+    $("segments {0}\tthreads {1}\t", segments.size(), pool.size()));
+
+  source->close();
+  sink->close();
+}
+
+std::vector<ParallelRenderer::Segment> ParallelRenderer::partition(const size_t frames) const
+{
+  // each segment should be substantially longer than its overhead,
+  // otherwise the warm-up frames will outweigh the parallel speedup
+  const size_t overhead = warmup + crossfade;
+  const size_t minsize = overhead * 4;
+
+  // but short enough to keep the memory bounded for long recordings,
+  // which are then rendered in several batches
+  const size_t maxsize = std::max<size_t>(minsize, 1024);
+
+  const size_t size = std::clamp((frames + pool.size() - 1) / pool.size(), std::max(minsize, size_t(1)), maxsize);
+
+  std::vector<Segment> segments;
+
+  for (size_t begin = 0; begin < frames; begin += size)
+  {
+    Segment segment;
+
+    segment.begin = begin;
+    segment.end = std::min(begin + size, frames);
+    segment.first = (begin > warmup) ? begin - warmup : 0;
+    segment.last = std::min(segment.end + crossfade, frames);
+    segment.stop = std::min(segment.last + warmup, frames);
+
+    segments.push_back(segment);
+  }
+
+  return segments;
+}
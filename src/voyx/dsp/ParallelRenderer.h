@@ -0,0 +1,59 @@
+#pragma once
+
+#include <voyx/Header.h>
+#include <voyx/dsp/Pipeline.h>
+#include <voyx/etc/ThreadPool.h>
+
+/**
+ * Renders a finite source offline by splitting it into segments,
+ * processing each segment by an individual pipeline instance in parallel
+ * and crossfading the adjacent segments into the sink.
+ *
+ * Each segment is preceded by the specified number of warm-up frames
+ * to prime the internal pipeline state, e.g. the STFT buffers, and followed by
+ * as many input frames to flush the pipeline latency, which thus must not exceed the warm-up.
+ * So only pipelines whose output depends on a bounded history of the input are supported,
+ * but not the ones accumulating the synthesis phase like the vocoder based ones,
+ * since the adjacent segments would not be phase coherent.
+ *
+ * The segments are rendered in batches of one segment per thread
+ * and written to the sink in order, so that the memory consumption
+ * doesn't grow with the length of the source.
+ *
+ * The segment pipelines run directly on the pool workers, since an offline render
+ * of a synchronous pipeline doesn't spawn a thread of its own.
+ **/
+class ParallelRenderer
+{
+
+public:
+
+  typedef std::function<std::shared_ptr<Pipeline<sample_t>>(
+    std::shared_ptr<Source<sample_t>> source,
+    std::shared_ptr<Sink<sample_t>> sink)> Factory;
+
+  ParallelRenderer(Factory factory, const size_t warmup, const size_t crossfade, const size_t threads = std::thread::hardware_concurrency());
+
+  void operator()(std::shared_ptr<Source<sample_t>> source, std::shared_ptr<Sink<sample_t>> sink);
+
+private:
+
+  struct Segment
+  {
+    size_t first;   // first rendered frame incl. warm-up
+    size_t begin;   // first frame owned by this segment
+    size_t end;     // end of frames owned by this segment
+    size_t last;    // end of rendered frames incl. crossfade
+    size_t stop;    // end of input frames incl. latency flush
+    std::vector<sample_t> output;
+  };
+
+  const Factory factory;
+  const size_t warmup;
+  const size_t crossfade;
+
+  ThreadPool pool;
+
+  std::vector<Segment> partition(const size_t frames) const;
+
+};
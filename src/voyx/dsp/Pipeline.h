@@ -1,6 +1,8 @@
 #pragma once
 
 #include <voyx/Header.h>
+#include <voyx/etc/Logger.h>
+#include <voyx/etc/Timer.h>
 #include <voyx/io/Sink.h>
 #include <voyx/io/Source.h>
 
@@ -43,8 +45,16 @@ public:
     const size_t frames = static_cast<size_t>(
       std::ceil(seconds * sink->samplerate() / sink->framesize()));
 
+    start(frames, timeout);
+  }
+
+  void start(const size_t frames,
+             const std::chrono::duration<double> timeout = std::chrono::duration<double>::zero())
+  {
     stop();
 
+    prepare(frames);
+
     source->start();
     sink->start();
 
@@ -64,12 +74,210 @@ public:
     sink->stop();
   }
 
+  /**
+   * Prepares an offline render of the specified number of frames, if the source is finite,
+   * and returns the number of frames to be processed including the lookahead().
+   * Used by start() and by hosts which step the pipeline frame by frame via render().
+   **/
+  size_t prepare(const size_t frames)
+  {
+    // a finite source is rendered as fast as possible
+    offline = (frames > 0 && source->frames() > 0) ? frames : 0;
+
+    return frames + lookahead();
+  }
+
+  /**
+   * Processes the specified frame of a prepared offline render,
+   * reading the input via pad() and writing the output via trim().
+   **/
+  bool render(const size_t index, voyx::function_ref<void(const voyx::vector<T> input, voyx::vector<T> output)> callback)
+  {
+    voyxassert(offline);
+
+    return pad(index, [&](const voyx::vector<T> input)
+    {
+      trim(index, [&](voyx::vector<T> output)
+      {
+        callback(input, output);
+      });
+    });
+  }
+
+  /**
+   * Returns the algorithmic delay between input and output in samples.
+   **/
+  virtual size_t latency() const
+  {
+    return 0;
+  }
+
+  /**
+   * Logs the rendered audio duration, the elapsed time since the specified timestamp
+   * and the resulting realtime factor, optionally preceded by further details.
+   **/
+  static void throughput(const size_t frames, const size_t framesize, const double samplerate,
+                         const std::chrono::steady_clock::time_point timestamp,
+                         const std::string& details = "")
+  {
+    const double elapsed = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - timestamp).count();
+
+    const double duration = frames * framesize / samplerate;
+
+    LOG(INFO)
+      << "Render: \t"
+      << "frames " << frames << "\t"
+      << details
+      << "duration " << duration << " s\t"
+      << "elapsed " << elapsed << " s\t"
+      << "realtime factor " << (elapsed > 0 ? duration / elapsed : 0);
+  }
+
+  /**
+   * Writes the timing statistics of the last run into
+   * a .json or .csv file, depending on the file extension.
+   **/
+  void dump(const std::string& path) const
+  {
+    std::ofstream file(path);
+
+    if (!file)
+    {
+      throw std::runtime_error("Unable to write " + path + "!");
+    }
+
+    const auto timers = statistics();
+
+    if (std::filesystem::path(path).extension() == ".csv")
+    {
+      file << Timer<std::chrono::milliseconds>::csvheader() << std::endl;
+
+      for (const auto& [name, timer] : timers)
+      {
+        file << timer->csv(name) << std::endl;
+      }
+    }
+    else
+    {
+      file << "{" << std::endl;
+      file << "  \"samplerate\": " << source->samplerate() << "," << std::endl;
+      file << "  \"framesize\": " << source->framesize() << "," << std::endl;
+      file << "  \"timers\": [" << std::endl;
+
+      for (size_t i = 0; i < timers.size(); ++i)
+      {
+        file << "    " << timers[i].second->json(timers[i].first)
+             << (i + 1 < timers.size() ? "," : "") << std::endl;
+      }
+
+      file << "  ]" << std::endl;
+      file << "}" << std::endl;
+    }
+  }
+
 public:
 
   const std::shared_ptr<Source<T>> source;
   const std::shared_ptr<Sink<T>> sink;
 
+protected:
+
+  /**
+   * Number of frames to be rendered offline, i.e. from a finite source
+   * without waiting for the sink, otherwise zero.
+   **/
+  size_t offline = 0;
+
+  /**
+   * Returns the number of frames to be processed in addition to an offline render,
+   * so that the output can be advanced by the latency without losing the tail.
+   **/
+  size_t lookahead() const
+  {
+    return offline ? latency() / sink->framesize() + 1 : 0;
+  }
+
+  /**
+   * Reads the specified frame from the source,
+   * or passes silence beyond the end of an offline render.
+   **/
+  bool pad(const size_t index, voyx::function_ref<void(const voyx::vector<T> frame)> callback)
+  {
+    if (!offline || index < source->frames())
+    {
+      return source->read(index, callback);
+    }
+
+    render.silence.resize(source->framesize() * source->channels());
+
+    callback(render.silence);
+
+    return true;
+  }
+
+  /**
+   * Passes the next frame of an offline render to the callback and writes the output to the sink
+   * advanced by the latency, so that the output is aligned with the input.
+   * So the first output frame is written after lookahead() frames have been processed.
+   **/
+  void trim(const size_t index, voyx::function_ref<void(voyx::vector<T> frame)> callback)
+  {
+    const size_t framesize = sink->framesize();
+    const size_t channels = sink->channels();
+
+    const size_t delay = latency();
+    const size_t frameshift = delay / framesize;
+    const size_t sampleshift = delay % framesize;
+
+    render.previous.resize(framesize * channels);
+    render.current.resize(framesize * channels);
+    render.frame.resize(framesize * channels);
+
+    callback(render.current);
+
+    if (index > frameshift && index - frameshift - 1 < offline)
+    {
+      for (size_t channel = 0; channel < channels; ++channel)
+      {
+        const T* previous = render.previous.data() + channel * framesize;
+        const T* current = render.current.data() + channel * framesize;
+
+        T* frame = render.frame.data() + channel * framesize;
+
+        // the tail of the previous frame followed by the head of the current one
+        std::copy(previous + sampleshift, previous + framesize, frame);
+        std::copy(current, current + sampleshift, frame + framesize - sampleshift);
+      }
+
+      sink->write(index - frameshift - 1, render.frame);
+    }
+
+    std::swap(render.previous, render.current);
+  }
+
+public:
+
   virtual void onstart(const size_t frames, const std::chrono::duration<double> timeout) = 0;
   virtual void onstop() = 0;
 
+  /**
+   * Returns the accumulated timers to be exported by dump().
+   **/
+  virtual std::vector<std::pair<std::string, const Timer<std::chrono::milliseconds>*>> statistics() const
+  {
+    return {};
+  }
+
+private:
+
+  struct
+  {
+    std::vector<T> silence;
+    std::vector<T> previous;
+    std::vector<T> current;
+    std::vector<T> frame;
+  }
+  render;
+
 };
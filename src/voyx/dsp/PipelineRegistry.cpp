@@ -0,0 +1,224 @@
+#include <voyx/dsp/PipelineRegistry.h>
+
+#include <voyx/Source.h>
+
+#include <voyx/dsp/AsyncGraphPipeline.h>
+#include <voyx/dsp/BypassPipeline.h>
+#include <voyx/dsp/GraphPipeline.h>
+#include <voyx/dsp/InverseSynthPipeline.h>
+#include <voyx/dsp/QdftTestPipeline.h>
+#include <voyx/dsp/RobotPipeline.h>
+#include <voyx/dsp/SdftTestPipeline.h>
+#include <voyx/dsp/SlidingVoiceSynthPipeline.h>
+#include <voyx/dsp/StftPipeline.h>
+#include <voyx/dsp/StftPitchShiftPipeline.h>
+#include <voyx/dsp/StftTestPipeline.h>
+#include <voyx/dsp/VoiceSynthPipeline.h>
+
+#include <voyx/fx/FormantEffect.h>
+#include <voyx/fx/HarmonicEffect.h>
+#include <voyx/fx/PitchShiftEffect.h>
+
+/**
+ * Builds the effect chain of the graph pipelines: formant preserving pitch shift,
+ * followed by the harmonic effect if there is a MIDI input.
+ **/
+static std::vector<std::shared_ptr<Effect>> effects(const PipelineRegistry::Options& options)
+{
+  std::vector<std::shared_ptr<Effect>> effects =
+  {
+    std::make_shared<FormantEffect>(
+      options.samplerate, options.dftsize,
+      options.quefrency.value_or(1e-3),
+      std::vector<std::shared_ptr<Effect>>
+      {
+        std::make_shared<PitchShiftEffect>(
+          options.samplerate, options.dftsize,
+          options.factors.value_or(std::vector<double>{ 1 }))
+      },
+      options.link, options.channel)
+  };
+
+  if (options.midi != nullptr)
+  {
+    effects.push_back(std::make_shared<HarmonicEffect>(
+      110, options.midi));
+  }
+
+  return effects;
+}
+
+std::vector<std::string> PipelineRegistry::names()
+{
+  std::vector<std::string> names;
+
+  for (const auto& [name, factory] : factories())
+  {
+    names.push_back(name);
+  }
+
+  return names;
+}
+
+bool PipelineRegistry::contains(const std::string& name)
+{
+  return factories().count($$::lower(name)) > 0;
+}
+
+std::vector<std::string> PipelineRegistry::linkables()
+{
+  // the graph pipelines pass the link on to the FormantEffect
+  return { "asyncgraph", "graph", "voicesynth" };
+}
+
+bool PipelineRegistry::linkable(const std::string& name)
+{
+  const auto names = linkables();
+
+  return std::find(names.begin(), names.end(), $$::lower(name)) != names.end();
+}
+
+bool PipelineRegistry::synchronous(const std::string& name)
+{
+  // all but the AsyncPipeline based ones
+  return $$::lower(name) != "asyncgraph";
+}
+
+bool PipelineRegistry::segmentable(const std::string& name)
+{
+  // all the others accumulate the synthesis phase of a vocoder or of oscillators,
+  // or like the QDFT depend on much longer input history than a few warm-up frames
+  const std::vector<std::string> names = { "bypass", "sdfttest", "stfttest" };
+
+  return std::find(names.begin(), names.end(), $$::lower(name)) != names.end();
+}
+
+std::shared_ptr<Pipeline<>> PipelineRegistry::create(const std::string& name,
+                                                     const Options& options,
+                                                     std::shared_ptr<Source<>> source,
+                                                     std::shared_ptr<Sink<>> sink)
+{
+  const auto factory = factories().find($$::lower(name));
+
+  if (factory == factories().end())
+  {
+    throw std::runtime_error($("Unknown pipeline \"{0}\", expected one of {1}!",
+                               name, $$::join(names(), ", ")));
+  }
+
+  auto pipeline = factory->second(options, source, sink);
+
+  if (options.hopthreads != 1)
+  {
+    if (auto stft = std::dynamic_pointer_cast<StftPipeline<>>(pipeline))
+    {
+      stft->parallelize(std::make_shared<ThreadPool>(options.hopthreads
+        ? options.hopthreads
+        : std::thread::hardware_concurrency()));
+    }
+  }
+
+  return pipeline;
+}
+
+const std::map<std::string, PipelineRegistry::Factory>& PipelineRegistry::factories()
+{
+  static const std::map<std::string, Factory> factories =
+  {
+    {
+      "asyncgraph", [](const Options& options, auto source, auto sink)
+      {
+        return std::make_shared<AsyncGraphPipeline>(
+          options.samplerate, options.framesize, options.hopsize, options.dftsize,
+          [options]() { return effects(options); },
+          source, sink, options.workers);
+      }
+    },
+    {
+      "bypass", [](const Options& options, auto source, auto sink)
+      {
+        return std::make_shared<BypassPipeline>(source, sink);
+      }
+    },
+    {
+      "graph", [](const Options& options, auto source, auto sink)
+      {
+        return std::make_shared<GraphPipeline>(
+          options.samplerate, options.framesize, options.hopsize, options.dftsize,
+          effects(options), source, sink);
+      }
+    },
+    {
+      "inversesynth", [](const Options& options, auto source, auto sink)
+      {
+        return std::make_shared<InverseSynthPipeline>(
+          options.samplerate, options.framesize, options.hopsize, options.dftsize,
+          source, sink, options.midi, options.plot);
+      }
+    },
+    {
+      "qdfttest", [](const Options& options, auto source, auto sink)
+      {
+        return std::make_shared<QdftTestPipeline>(
+          options.samplerate, options.framesize,
+          source, sink, options.midi, options.plot);
+      }
+    },
+    {
+      "robot", [](const Options& options, auto source, auto sink)
+      {
+        return std::make_shared<RobotPipeline>(
+          options.samplerate, options.framesize, options.dftsize,
+          source, sink, options.midi, options.plot);
+      }
+    },
+    {
+      "sdfttest", [](const Options& options, auto source, auto sink)
+      {
+        return std::make_shared<SdftTestPipeline>(
+          options.samplerate, options.framesize, options.dftsize,
+          source, sink, options.midi, options.plot);
+      }
+    },
+    {
+      "slidingvoicesynth", [](const Options& options, auto source, auto sink)
+      {
+        return std::make_shared<SlidingVoiceSynthPipeline>(
+          options.samplerate, options.framesize, options.dftsize,
+          options.quefrency.value_or(1e-3),
+          source, sink, options.midi, options.plot);
+      }
+    },
+    {
+      "stftpitchshift", [](const Options& options, auto source, auto sink)
+      {
+        return std::make_shared<StftPitchShiftPipeline>(
+          options.samplerate, options.framesize, options.hopsize, options.dftsize,
+          options.factors.value_or(std::vector<double>{ 1 }),
+          options.quefrency.value_or(0),
+          source, sink, options.midi, options.plot);
+      }
+    },
+    {
+      "stfttest", [](const Options& options, auto source, auto sink)
+      {
+        return std::make_shared<StftTestPipeline>(
+          options.samplerate, options.framesize, options.hopsize, options.dftsize,
+          source, sink, options.midi, options.plot);
+      }
+    },
+    {
+      "voicesynth", [](const Options& options, auto source, auto sink)
+      {
+        return std::make_shared<VoiceSynthPipeline>(
+          options.samplerate, options.framesize, options.hopsize, options.dftsize,
+          options.factors.value_or(std::vector<double>{ 0.5, 1.25, 1.5, 2 }),
+          options.quefrency.value_or(1e-3),
+          source, sink, options.midi, options.plot,
+          options.link, options.channel);
+      }
+    },
+  };
+
+  return factories;
+}
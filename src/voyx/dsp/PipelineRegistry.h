@@ -0,0 +1,78 @@
+#pragma once
+
+#include <voyx/Header.h>
+#include <voyx/dsp/ChannelLink.h>
+#include <voyx/dsp/Pipeline.h>
+#include <voyx/io/MidiObserver.h>
+#include <voyx/ui/Plot.h>
+
+/**
+ * Registry of the available pipelines, which can be selected by name at runtime.
+ *
+ * Unspecified optional parameters fall back to the defaults of the particular pipeline,
+ * e.g. a unity pitch shifting factor for the StftPitchShiftPipeline.
+ **/
+class PipelineRegistry
+{
+
+public:
+
+  struct Options
+  {
+    double samplerate;
+    size_t framesize;
+    size_t hopsize;
+    size_t dftsize;
+
+    std::optional<std::vector<double>> factors;
+    std::optional<double> quefrency;
+
+    size_t workers = 0; // asynchronous pipelines only, 0 for all cores
+    size_t hopthreads = 1; // intra-frame parallel STFT pipelines only, 0 for all cores
+
+    std::shared_ptr<ChannelLink> link; // linked multichannel processing only
+    size_t channel = 0;
+
+    std::shared_ptr<MidiObserver> midi;
+    std::shared_ptr<Plot> plot;
+  };
+
+  typedef std::function<std::shared_ptr<Pipeline<>>(
+    const Options& options,
+    std::shared_ptr<Source<>> source,
+    std::shared_ptr<Sink<>> sink)> Factory;
+
+  static std::vector<std::string> names();
+
+  static bool contains(const std::string& name);
+
+  /**
+   * Returns the names of the pipelines, which actually share their analysis
+   * via the ChannelLink option in the linked multichannel mode.
+   **/
+  static std::vector<std::string> linkables();
+
+  static bool linkable(const std::string& name);
+
+  /**
+   * Returns whether the specified pipeline is a SyncPipeline, which is required
+   * for the multichannel mode and for hosting sessions.
+   **/
+  static bool synchronous(const std::string& name);
+
+  /**
+   * Returns whether the output of the specified pipeline depends on a bounded history
+   * of the input only, so that the ParallelRenderer can render it in segments.
+   **/
+  static bool segmentable(const std::string& name);
+
+  static std::shared_ptr<Pipeline<>> create(const std::string& name,
+                                            const Options& options,
+                                            std::shared_ptr<Source<>> source,
+                                            std::shared_ptr<Sink<>> sink);
+
+private:
+
+  static const std::map<std::string, Factory>& factories();
+
+};
@@ -4,7 +4,10 @@
 #include <voyx/alg/QDFT.h>
 #include <voyx/dsp/SyncPipeline.h>
 
-template<typename T = sample_t>
+/**
+ * The template parameter T specifies the frequency domain precision.
+ **/
+template<typename T = phasor_t::value_type>
 class QdftPipeline : public SyncPipeline<sample_t>
 {
 
@@ -31,22 +34,32 @@ protected:
 
   void operator()(const size_t index, const voyx::vector<sample_t> input, voyx::vector<sample_t> output) override
   {
-    voyx::matrix<phasor_t> dfts(data.dfts, qdft.size());
+    voyxassert(input.size() <= framesize);
+
+    voyx::matrix<std::complex<T>> dfts(data.dfts.data(), input.size() * qdft.size(), qdft.size());
+
+    {
+      VOYXZONE("qdft");
+      qdft.qdft(dfts.size(), input.data(), dfts.data());
+    }
 
-    qdft.qdft(dfts.size(), input.data(), dfts.data());
     (*this)(index, dfts);
-    qdft.iqdft(dfts.size(), dfts.data(), output.data());
+
+    {
+      VOYXZONE("iqdft");
+      qdft.iqdft(dfts.size(), dfts.data(), output.data());
+    }
   }
 
-  virtual void operator()(const size_t index, voyx::matrix<phasor_t> dfts) = 0;
+  virtual void operator()(const size_t index, voyx::matrix<std::complex<T>> dfts) = 0;
 
 private:
 
-  QDFT<sample_t, phasor_t::value_type> qdft;
+  QDFT<sample_t, T> qdft;
 
   struct
   {
-    std::vector<phasor_t> dfts;
+    std::vector<std::complex<T>> dfts;
   }
   data;
 
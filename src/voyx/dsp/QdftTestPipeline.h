@@ -5,7 +5,7 @@
 #include <voyx/io/MidiObserver.h>
 #include <voyx/ui/Plot.h>
 
-class QdftTestPipeline : public QdftPipeline<double>
+class QdftTestPipeline : public QdftPipeline<>
 {
 
 public:
@@ -7,50 +7,41 @@ RobotPipeline::RobotPipeline(const double samplerate, const size_t framesize, co
                              std::shared_ptr<MidiObserver> midi, std::shared_ptr<Plot> plot) :
   SdftPipeline(samplerate, framesize, dftsize, source, sink),
   midi(midi),
+  midievents(midi ? midi->subscribe() : nullptr),
   plot(plot)
 {
+  // current and sustained keys
+  frequencies.reserve(128 * 2);
+  data.frequencies.reserve(128 * 2);
+
+  data.events.resize(1024);
+  data.keys.fill(0);
+  data.sustain = false;
+
+  data.abs.resize(dftsize);
 }
 
 void RobotPipeline::operator()(const size_t index,
                                voyx::matrix<phasor_t> dfts)
 {
-  std::set<double> frequencies;
-  bool sustain = false;
-
-  if (midi != nullptr)
-  {
-    const auto values = midi->frequencies();
-    frequencies.insert(values.begin(), values.end());
+  const size_t events = (midi != nullptr)
+    ? midi->events(*midievents, samplerate, dfts.size(), data.events)
+    : 0;
 
-    sustain = midi->sustain();
-  }
+  std::vector<phasor_t::value_type>& abs = data.abs;
 
-  if (sustain)
+  for (size_t i = 0, e = 0; i < dfts.size(); ++i)
   {
-    frequencies.merge(this->frequencies);
-  }
-
-  this->frequencies = frequencies;
-
-  for (const double frequency : frequencies)
-  {
-    if (osc.count(frequency))
+    if (e < events && data.events[e].offset <= i)
     {
-      continue;
-    }
-
-    osc[frequency].resize(dftsize);
+      while (e < events && data.events[e].offset <= i)
+      {
+        apply(data.events[e++]);
+      }
 
-    for (size_t i = 0; i < dftsize; ++i)
-    {
-      osc[frequency][i] = { i * frequency, samplerate };
+      update();
     }
-  }
-
-  std::vector<double> abs(dftsize);
 
-  for (size_t i = 0; i < dfts.size(); ++i)
-  {
     auto dft = dfts[i];
 
     for (size_t j = 0; j < dft.size(); ++j)
@@ -76,3 +67,59 @@ void RobotPipeline::operator()(const size_t index,
     }
   }
 }
+
+void RobotPipeline::apply(const MidiObserver::Event& event)
+{
+  switch (event.type)
+  {
+  case MidiObserver::Event::Type::Note:
+    data.keys[event.key] = event.value ? event.frequency : 0;
+    break;
+  case MidiObserver::Event::Type::Sustain:
+    data.sustain = event.value;
+    break;
+  case MidiObserver::Event::Type::Reset:
+    data.keys.fill(0);
+    break;
+  }
+}
+
+void RobotPipeline::update()
+{
+  std::vector<double>& frequencies = data.frequencies;
+
+  frequencies.clear();
+
+  for (const double frequency : data.keys)
+  {
+    if (frequency)
+    {
+      frequencies.push_back(frequency);
+    }
+  }
+
+  if (data.sustain)
+  {
+    frequencies.insert(frequencies.end(), this->frequencies.begin(), this->frequencies.end());
+  }
+
+  std::sort(frequencies.begin(), frequencies.end());
+  frequencies.erase(std::unique(frequencies.begin(), frequencies.end()), frequencies.end());
+
+  this->frequencies.assign(frequencies.begin(), frequencies.end());
+
+  for (const double frequency : frequencies)
+  {
+    if (osc.count(frequency))
+    {
+      continue;
+    }
+
+    osc[frequency].resize(dftsize);
+
+    for (size_t i = 0; i < dftsize; ++i)
+    {
+      osc[frequency][i] = { i * frequency, samplerate };
+    }
+  }
+}
@@ -21,9 +21,24 @@ public:
 private:
 
   std::shared_ptr<MidiObserver> midi;
+  std::shared_ptr<MidiObserver::Events> midievents;
   std::shared_ptr<Plot> plot;
 
-  std::map<double, std::vector<Oscillator<double>>> osc;
-  std::set<double> frequencies;
+  std::map<double, std::vector<Oscillator<phasor_t::value_type>>> osc;
+  std::vector<double> frequencies;
+
+  struct
+  {
+    std::vector<MidiObserver::Event> events;
+    std::array<double, 128> keys;
+    bool sustain;
+
+    std::vector<double> frequencies;
+    std::vector<phasor_t::value_type> abs;
+  }
+  data;
+
+  void apply(const MidiObserver::Event& event);
+  void update();
 
 };
@@ -4,7 +4,10 @@
 #include <voyx/alg/SDFT.h>
 #include <voyx/dsp/SyncPipeline.h>
 
-template<typename T = sample_t>
+/**
+ * The template parameter T specifies the frequency domain precision.
+ **/
+template<typename T = phasor_t::value_type>
 class SdftPipeline : public SyncPipeline<sample_t>
 {
 
@@ -28,22 +31,32 @@ protected:
 
   void operator()(const size_t index, const voyx::vector<sample_t> input, voyx::vector<sample_t> output) override
   {
-    voyx::matrix<phasor_t> dfts(data.dfts, dftsize);
+    voyxassert(input.size() <= framesize);
+
+    voyx::matrix<std::complex<T>> dfts(data.dfts.data(), input.size() * dftsize, dftsize);
+
+    {
+      VOYXZONE("sdft");
+      sdft.sdft(dfts.size(), input.data(), dfts.data());
+    }
 
-    sdft.sdft(dfts.size(), input.data(), dfts.data());
     (*this)(index, dfts);
-    sdft.isdft(dfts.size(), dfts.data(), output.data());
+
+    {
+      VOYXZONE("isdft");
+      sdft.isdft(dfts.size(), dfts.data(), output.data());
+    }
   }
 
-  virtual void operator()(const size_t index, voyx::matrix<phasor_t> dfts) = 0;
+  virtual void operator()(const size_t index, voyx::matrix<std::complex<T>> dfts) = 0;
 
 private:
 
-  SDFT<sample_t, phasor_t::value_type> sdft;
+  SDFT<sample_t, T> sdft;
 
   struct
   {
-    std::vector<phasor_t> dfts;
+    std::vector<std::complex<T>> dfts;
   }
   data;
 
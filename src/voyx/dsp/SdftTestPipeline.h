@@ -6,7 +6,7 @@
 #include <voyx/io/MidiObserver.h>
 #include <voyx/ui/Plot.h>
 
-class SdftTestPipeline : public SdftPipeline<double>
+class SdftTestPipeline : public SdftPipeline<>
 {
 
 public:
@@ -20,7 +20,7 @@ public:
 
 private:
 
-  Vocoder<double> vocoder;
+  Vocoder<phasor_t::value_type> vocoder;
 
   std::shared_ptr<MidiObserver> midi;
   std::shared_ptr<Plot> plot;
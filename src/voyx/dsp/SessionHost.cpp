@@ -0,0 +1,292 @@
+#include <voyx/dsp/SessionHost.h>
+
+#include <voyx/Source.h>
+
+SessionHost::SessionHost(const double headroom, const size_t threads) :
+  headroom(std::clamp(headroom, 0.0, 1.0)),
+  scheduler(threads)
+{
+}
+
+SessionHost::~SessionHost()
+{
+  stop();
+
+  for (auto& [id, session] : sessions)
+  {
+    session->pipeline->close();
+  }
+}
+
+size_t SessionHost::size() const
+{
+  std::lock_guard lock(mutex);
+
+  return sessions.size();
+}
+
+double SessionHost::load() const
+{
+  std::lock_guard lock(mutex);
+
+  return utilization() / scheduler.threads();
+}
+
+std::optional<size_t> SessionHost::admit(std::shared_ptr<Pipeline<sample_t>> pipeline)
+{
+  auto sync = std::dynamic_pointer_cast<SyncPipeline<sample_t>>(pipeline);
+
+  if (sync == nullptr)
+  {
+    throw std::runtime_error(
+      "Only synchronous pipelines can be hosted as sessions!");
+  }
+
+  {
+    std::lock_guard lock(mutex);
+
+    // a new session is assumed to utilize as much as the running ones on average,
+    // so until the first measurement all sessions are admitted
+    const double total = utilization();
+    const double estimate = (total + (sessions.empty() ? 0 : total / sessions.size())) / scheduler.threads();
+
+    if (estimate > 1 - headroom)
+    {
+      LOG(WARNING) << $("Rejecting a new session at {0:.1f} % estimated load!", estimate * 1e+2);
+
+      return std::nullopt;
+    }
+  }
+
+  auto session = std::make_shared<Session>();
+
+  session->frames = 0;
+  session->total = 0;
+  session->pipeline = sync;
+  session->period = std::chrono::duration<double>(
+    pipeline->source->framesize() / pipeline->source->samplerate());
+  session->utilization = 0;
+  session->inner.deadline(session->period);
+  session->response.deadline(session->period);
+
+  pipeline->open();
+  pipeline->source->start();
+  pipeline->sink->start();
+
+  std::lock_guard lock(mutex);
+
+  session->id = scheduler.add(session->period,
+    [this, session](const size_t index, const DeadlineScheduler::clock::time_point deadline)
+    {
+      return step(*session, index, deadline);
+    });
+
+  sessions[session->id] = session;
+
+  return session->id;
+}
+
+void SessionHost::start(const size_t frames)
+{
+  stop();
+
+  this->frames = frames;
+
+  if (frames > 0)
+  {
+    // offline sessions are padded and trimmed by the latency like a single pipeline render
+    for (auto& [id, session] : sessions)
+    {
+      const size_t available = session->pipeline->source->frames();
+
+      session->total = session->pipeline->prepare(available ? std::min(frames, available) : frames);
+    }
+
+    scheduler.start(false);
+    scheduler.wait();
+    scheduler.stop();
+
+    report();
+
+    return;
+  }
+
+  doloop = true;
+
+  scheduler.start(true);
+
+  thread = std::make_shared<std::thread>([this]()
+  {
+    std::unique_lock lock(mutex);
+
+    while (doloop)
+    {
+      if (!condition.wait_for(lock, std::chrono::seconds(5), [this]() { return !doloop; }))
+      {
+        lock.unlock();
+        report();
+        lock.lock();
+      }
+    }
+  });
+}
+
+void SessionHost::stop()
+{
+  if (thread == nullptr)
+  {
+    return;
+  }
+
+  {
+    std::lock_guard lock(mutex);
+
+    doloop = false;
+  }
+
+  condition.notify_all();
+
+  if (thread->joinable())
+  {
+    thread->join();
+  }
+
+  thread = nullptr;
+
+  scheduler.stop();
+
+  report();
+}
+
+double SessionHost::utilization() const
+{
+  double sum = 0;
+
+  for (const auto& [id, session] : sessions)
+  {
+    sum += session->utilization;
+  }
+
+  return sum;
+}
+
+bool SessionHost::step(Session& session, const size_t index, const DeadlineScheduler::clock::time_point deadline)
+{
+  // smoothing factor of the utilization measurement
+  const double alpha = 0.1;
+
+  if (frames > 0 && index >= session.total)
+  {
+    retire(session);
+    return false;
+  }
+
+  auto& pipeline = session.pipeline;
+  auto& source = pipeline->source;
+  auto& sink = pipeline->sink;
+
+  std::chrono::duration<double> cost = std::chrono::duration<double>::zero();
+
+  auto process = [&](const voyx::vector<sample_t> input, voyx::vector<sample_t> output)
+  {
+    const auto timestamp = std::chrono::steady_clock::now();
+
+    pipeline->process(index, input, output);
+
+    cost = std::chrono::steady_clock::now() - timestamp;
+    session.inner.add(cost);
+  };
+
+  const bool offline = frames > 0 && source->frames() > 0;
+
+  const bool ok = offline ? pipeline->render(index, process) : source->read(index, [&](const voyx::vector<sample_t> input)
+  {
+    sink->sync();
+    sink->write(index, [&](voyx::vector<sample_t> output)
+    {
+      process(input, output);
+    });
+
+    const size_t samples =
+      source->latency() +
+      pipeline->latency() +
+      sink->latency();
+
+    session.latency.add(std::chrono::duration<double>(samples / source->samplerate()));
+  });
+
+  // the deadline is one period after the frame arrival
+  session.response.add(std::chrono::steady_clock::now() - deadline + session.period);
+
+  session.utilization = session.utilization + alpha * (cost / session.period - session.utilization);
+
+  if (ok)
+  {
+    session.frames++;
+  }
+  else if (source->frames() > 0)
+  {
+    retire(session);
+    return false;
+  }
+
+  return true;
+}
+
+void SessionHost::retire(Session& session)
+{
+  LOG(INFO) << $("Session {0} finished after {1} frames.",
+                 session.id, session.frames);
+
+  session.pipeline->close();
+
+  std::lock_guard lock(mutex);
+
+  // keep the statistics of the session for the next report
+  retired.push_back(sessions.at(session.id));
+  sessions.erase(session.id);
+}
+
+void SessionHost::report()
+{
+  std::lock_guard lock(mutex);
+
+  // the timers are drained, since the workers keep recording meanwhile
+  auto print = [](Session& session, const std::string& status)
+  {
+    Timer<std::chrono::milliseconds> inner;
+    Timer<std::chrono::milliseconds> response;
+    Timer<std::chrono::milliseconds> latency;
+
+    session.inner.drain(inner);
+    session.response.drain(response);
+    session.latency.drain(latency);
+
+    const size_t count = response.count();
+
+    LOG(INFO)
+      << "Session " << session.id << status << ": \t"
+      << "inner " << inner.str() << "\t"
+      << "response " << response.str() << "\t"
+      << "latency " << latency.str() << "\t"
+      << "miss rate " << $("{0:.2f}", count ? 1e+2 * response.misses() / count : 0.0) << " %";
+  };
+
+  for (const auto& [id, session] : sessions)
+  {
+    print(*session, "");
+  }
+
+  for (const auto& session : retired)
+  {
+    print(*session, " (finished)");
+  }
+
+  retired.clear();
+
+  LOG(INFO)
+    << "Host: \t"
+    << "sessions " << sessions.size() << "\t"
+    << "threads " << scheduler.threads() << "\t"
+    << "load " << $("{0:.1f}", utilization() / scheduler.threads() * 1e+2) << " %";
+}
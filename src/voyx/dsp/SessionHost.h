@@ -0,0 +1,89 @@
+#pragma once
+
+#include <voyx/Header.h>
+#include <voyx/dsp/DeadlineScheduler.h>
+#include <voyx/dsp/SyncPipeline.h>
+#include <voyx/etc/Timer.h>
+
+/**
+ * Hosts many independent pipeline sessions in one process,
+ * each of them with its own source and sink.
+ *
+ * Instead of running a thread per pipeline, each frame of each session is processed
+ * as a task of the shared DeadlineScheduler, which is due at the arrival of the next frame.
+ * So the sessions may even have different sample rates and frame sizes.
+ *
+ * New sessions are only admitted as long as the measured utilization of the workers
+ * plus the estimated utilization of one more session leaves the specified headroom.
+ **/
+class SessionHost
+{
+
+public:
+
+  SessionHost(const double headroom = 0.25, const size_t threads = std::thread::hardware_concurrency());
+  ~SessionHost();
+
+  /**
+   * Returns the number of active sessions.
+   **/
+  size_t size() const;
+
+  /**
+   * Returns the smoothed ratio of the processing time to the available worker time.
+   **/
+  double load() const;
+
+  /**
+   * Adds the specified pipeline as a new session, which is opened immediately
+   * and scheduled as soon as the host is started, unless there is not enough headroom.
+   * Returns the session id if admitted.
+   **/
+  std::optional<size_t> admit(std::shared_ptr<Pipeline<sample_t>> pipeline);
+
+  /**
+   * Processes the specified number of frames per session as fast as possible,
+   * or all sessions in real time until stopped, if zero.
+   **/
+  void start(const size_t frames = 0);
+  void stop();
+
+private:
+
+  struct Session
+  {
+    size_t id;
+    size_t frames;
+    size_t total; // offline only, including the lookahead
+
+    std::shared_ptr<SyncPipeline<sample_t>> pipeline;
+    std::chrono::duration<double> period;
+
+    std::atomic<double> utilization;
+
+    Timer<std::chrono::milliseconds> inner;
+    Timer<std::chrono::milliseconds> latency;
+    Timer<std::chrono::milliseconds> response; // from frame arrival to completion
+  };
+
+  const double headroom;
+
+  DeadlineScheduler scheduler;
+
+  std::map<size_t, std::shared_ptr<Session>> sessions;
+  std::vector<std::shared_ptr<Session>> retired; // until the next report
+  size_t frames = 0;
+
+  std::shared_ptr<std::thread> thread;
+  bool doloop = false;
+
+  mutable std::mutex mutex;
+  std::condition_variable condition;
+
+  double utilization() const;
+
+  bool step(Session& session, const size_t index, const DeadlineScheduler::clock::time_point deadline);
+  void retire(Session& session);
+  void report();
+
+};
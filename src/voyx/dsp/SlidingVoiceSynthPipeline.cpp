@@ -2,17 +2,28 @@
 
 #include <voyx/Source.h>
 
-SlidingVoiceSynthPipeline::SlidingVoiceSynthPipeline(const double samplerate, const size_t framesize, const size_t dftsize,
+SlidingVoiceSynthPipeline::SlidingVoiceSynthPipeline(const double samplerate, const size_t framesize, const size_t dftsize, const double quefrency,
                                                      std::shared_ptr<Source<sample_t>> source, std::shared_ptr<Sink<sample_t>> sink,
                                                      std::shared_ptr<MidiObserver> midi, std::shared_ptr<Plot> plot) :
   SdftPipeline(samplerate, framesize, dftsize, source, sink),
   midi(midi),
   plot(plot),
   vocoder(samplerate, framesize, 1, dftsize),
-  lifter(1e-3, samplerate, dftsize * 2),
+  lifter(quefrency, samplerate, dftsize * 2),
   pda({ 50, 1000 }, samplerate),
   ptr(442)
 {
+  // current and sustained keys
+  frequencies.reserve(128 * 2);
+  data.frequencies.reserve(128 * 2);
+
+  data.envelope.resize(dftsize);
+  data.spectrum.resize(dftsize);
+  data.cepstrum.resize(dftsize * 2);
+
+  data.abs0.resize(dftsize);
+  data.abs1.resize(dftsize);
+
   if (plot != nullptr)
   {
     plot->xmap(samplerate / 2);
@@ -24,32 +35,39 @@ SlidingVoiceSynthPipeline::SlidingVoiceSynthPipeline(const double samplerate, co
 void SlidingVoiceSynthPipeline::operator()(const size_t index,
                                            voyx::matrix<phasor_t> dfts)
 {
-  std::set<double> frequencies;
+  std::vector<double>& frequencies = data.frequencies;
   bool sustain = false;
 
+  frequencies.clear();
+
   if (midi != nullptr)
   {
-    const auto values = midi->frequencies();
-    frequencies.insert(values.begin(), values.end());
+    midi->snapshot(data.snapshot);
+
+    const auto notes = data.snapshot.notes();
+    frequencies.insert(frequencies.end(), notes.begin(), notes.end());
 
-    sustain = midi->sustain();
+    sustain = data.snapshot.sustain;
   }
 
   if (sustain)
   {
-    frequencies.merge(this->frequencies);
+    frequencies.insert(frequencies.end(), this->frequencies.begin(), this->frequencies.end());
   }
 
-  this->frequencies = frequencies;
+  std::sort(frequencies.begin(), frequencies.end());
+  frequencies.erase(std::unique(frequencies.begin(), frequencies.end()), frequencies.end());
+
+  this->frequencies.assign(frequencies.begin(), frequencies.end());
 
   vocoder.encode(dfts);
 
-  std::vector<double> envelope(dfts.stride());
-  std::vector<double> spectrum(dfts.stride());
-  std::vector<double> cepstrum(dfts.stride() * 2);
+  std::vector<phasor_t::value_type>& envelope = data.envelope;
+  std::vector<phasor_t::value_type>& spectrum = data.spectrum;
+  std::vector<phasor_t::value_type>& cepstrum = data.cepstrum;
 
-  std::vector<double> abs0(dfts.stride());
-  std::vector<double> abs1(dfts.stride());
+  std::vector<phasor_t::value_type>& abs0 = data.abs0;
+  std::vector<phasor_t::value_type>& abs1 = data.abs1;
 
   lifter.lowpass<$$::real>(dfts.front(), envelope, spectrum, cepstrum);
 
@@ -75,7 +93,7 @@ void SlidingVoiceSynthPipeline::operator()(const size_t index,
 
       for (size_t i = 0; i < dft.size(); ++i)
       {
-        dft[i].real(std::max(abs1[i] * invratio, dft[i].real()));
+        dft[i].real(std::max<phasor_t::value_type>(abs1[i] * invratio, dft[i].real()));
       }
     }
 
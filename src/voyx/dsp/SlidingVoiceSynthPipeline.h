@@ -9,12 +9,12 @@
 #include <voyx/io/MidiObserver.h>
 #include <voyx/ui/Plot.h>
 
-class SlidingVoiceSynthPipeline : public SdftPipeline<double>
+class SlidingVoiceSynthPipeline : public SdftPipeline<>
 {
 
 public:
 
-  SlidingVoiceSynthPipeline(const double samplerate, const size_t framesize, const size_t dftsize,
+  SlidingVoiceSynthPipeline(const double samplerate, const size_t framesize, const size_t dftsize, const double quefrency,
                             std::shared_ptr<Source<sample_t>> source, std::shared_ptr<Sink<sample_t>> sink,
                             std::shared_ptr<MidiObserver> midi, std::shared_ptr<Plot> plot);
 
@@ -26,12 +26,26 @@ private:
   std::shared_ptr<MidiObserver> midi;
   std::shared_ptr<Plot> plot;
 
-  Vocoder<double> vocoder;
-  Lifter<double> lifter;
+  Vocoder<phasor_t::value_type> vocoder;
+  Lifter<phasor_t::value_type> lifter;
 
-  SpectralPitchDetector<double> pda;
+  SpectralPitchDetector<phasor_t::value_type> pda;
   NaivePitchTracking ptr;
 
-  std::set<double> frequencies;
+  std::vector<double> frequencies;
+
+  struct
+  {
+    MidiObserver::Snapshot snapshot;
+    std::vector<double> frequencies;
+
+    std::vector<phasor_t::value_type> envelope;
+    std::vector<phasor_t::value_type> spectrum;
+    std::vector<phasor_t::value_type> cepstrum;
+
+    std::vector<phasor_t::value_type> abs0;
+    std::vector<phasor_t::value_type> abs1;
+  }
+  data;
 
 };
@@ -4,7 +4,10 @@
 #include <voyx/alg/STFT.h>
 #include <voyx/dsp/SyncPipeline.h>
 
-template<typename T = sample_t>
+/**
+ * The template parameter T specifies the frequency domain precision.
+ **/
+template<typename T = phasor_t::value_type>
 class StftPipeline : public SyncPipeline<sample_t>
 {
 
@@ -16,11 +19,27 @@ public:
     framesize(framesize),
     hopsize(hopsize),
     dftsize(dftsize),
-    stft(framesize, hopsize, dftsize)
+    stft(framesize, hopsize, dftsize, source->framesize())
   {
     data.dfts.resize(stft.hops().size() * stft.size());
   }
 
+  size_t latency() const override
+  {
+    return stft.latency();
+  }
+
+  /**
+   * Enables the intra-frame parallel mode, which distributes the forward and inverse FFT
+   * as well as the per-hop callbacks of each frame across the specified thread pool.
+   **/
+  virtual void parallelize(std::shared_ptr<ThreadPool> pool)
+  {
+    this->pool = pool;
+
+    stft.parallelize(pool);
+  }
+
 protected:
 
   const double samplerate;
@@ -30,22 +49,65 @@ protected:
 
   void operator()(const size_t index, const voyx::vector<sample_t> input, voyx::vector<sample_t> output) override
   {
-    voyx::matrix<phasor_t> dfts(data.dfts, stft.size());
+    voyx::matrix<std::complex<T>> dfts(data.dfts, stft.size());
+
+    {
+      VOYXZONE("stft");
+      stft.stft(input, dfts);
+    }
 
-    stft.stft(input, dfts);
     (*this)(index, stft.signal(), dfts);
-    stft.istft(dfts, output);
+
+    {
+      VOYXZONE("istft");
+      stft.istft(dfts, output);
+    }
   }
 
-  virtual void operator()(const size_t index, const voyx::vector<sample_t> signal, voyx::matrix<phasor_t> dfts) = 0;
+  virtual void operator()(const size_t index, const voyx::vector<sample_t> signal, voyx::matrix<std::complex<T>> dfts) = 0;
+
+  /**
+   * Returns the number of hops, i.e. dfts, per frame.
+   **/
+  size_t hops() const
+  {
+    return stft.hops().size();
+  }
+
+  /**
+   * Invokes the callback for each hop, concurrently in the intra-frame parallel mode.
+   * So the callback must not modify any state which is shared between the hops.
+   **/
+  void foreach(voyx::matrix<std::complex<T>> dfts, voyx::function_ref<void(const size_t hop, voyx::vector<std::complex<T>> dft)> callback)
+  {
+    if (pool == nullptr || dfts.size() < 2)
+    {
+      for (size_t hop = 0; hop < dfts.size(); ++hop)
+      {
+        callback(hop, dfts[hop]);
+      }
+
+      return;
+    }
+
+    pool->chunks(dfts.size(), [&](const size_t first, const size_t last)
+    {
+      for (size_t hop = first; hop < last; ++hop)
+      {
+        callback(hop, dfts[hop]);
+      }
+    });
+  }
 
 private:
 
-  STFT<sample_t, phasor_t::value_type> stft;
+  STFT<sample_t, T> stft;
+
+  std::shared_ptr<ThreadPool> pool;
 
   struct
   {
-    std::vector<phasor_t> dfts;
+    std::vector<std::complex<T>> dfts;
   }
   data;
 
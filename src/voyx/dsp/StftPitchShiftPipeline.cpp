@@ -5,12 +5,14 @@
 using namespace stftpitchshift;
 
 StftPitchShiftPipeline::StftPitchShiftPipeline(const double samplerate, const size_t framesize, const size_t hopsize, const size_t dftsize,
+                                               const std::vector<double>& factors, const double quefrency,
                                                std::shared_ptr<Source<sample_t>> source, std::shared_ptr<Sink<sample_t>> sink,
                                                std::shared_ptr<MidiObserver> midi, std::shared_ptr<Plot> plot) :
   SyncPipeline<>(source, sink),
   samplerate(samplerate),
   framesize(std::make_tuple(dftsize * 2 - 2, framesize)),
   hopsize(hopsize),
+  blocksize(source->framesize()),
   midi(midi),
   plot(plot)
 {
@@ -21,25 +23,33 @@ StftPitchShiftPipeline::StftPitchShiftPipeline(const double samplerate, const si
     plot->ylim(-120, 0);
   }
 
+  voyxassert(blocksize % hopsize == 0);
+  voyxassert(blocksize <= std::get<1>(this->framesize));
+
   const size_t total_buffer_size =
     std::get<0>(this->framesize) +
-    std::get<1>(this->framesize);
+    blocksize;
 
   buffer.input.resize(total_buffer_size);
   buffer.output.resize(total_buffer_size);
 
-  stft = std::make_shared<STFT<double>>(this->framesize, hopsize);
-  core = std::make_shared<StftPitchShiftCore<double>>(this->framesize, hopsize, samplerate);
+  stft = std::make_shared<STFT<phasor_t::value_type>>(this->framesize, hopsize);
+  core = std::make_shared<StftPitchShiftCore<phasor_t::value_type>>(this->framesize, hopsize, samplerate);
 
-  core->factors({ 1 });
-  core->quefrency(0 * 1e-3);
+  core->factors(factors);
+  core->quefrency(quefrency);
   core->distortion(1);
   core->normalization(false);
 }
 
+size_t StftPitchShiftPipeline::latency() const
+{
+  return std::get<1>(framesize);
+}
+
 void StftPitchShiftPipeline::operator()(const size_t index, const voyx::vector<sample_t> input, voyx::vector<sample_t> output)
 {
-  auto show = [&](std::span<std::complex<double>> dft)
+  auto show = [&](std::span<phasor_t> dft)
   {
     if (plot != nullptr)
     {
@@ -57,8 +67,10 @@ void StftPitchShiftPipeline::operator()(const size_t index, const voyx::vector<s
   const auto analysis_window_size = std::get<0>(framesize);
   const auto synthesis_window_size = std::get<1>(framesize);
 
+  voyxassert(input.size() == blocksize);
+
   std::copy(
-    buffer.input.begin() + synthesis_window_size,
+    buffer.input.begin() + blocksize,
     buffer.input.end(),
     buffer.input.begin());
 
@@ -69,7 +81,7 @@ void StftPitchShiftPipeline::operator()(const size_t index, const voyx::vector<s
 
   size_t hop = 0;
 
-  (*stft)(buffer.input, buffer.output, [&](std::span<std::complex<double>> dft)
+  (*stft)(buffer.input, buffer.output, [&](std::span<phasor_t> dft)
   {
     if (!hop)
     {
@@ -83,11 +95,11 @@ void StftPitchShiftPipeline::operator()(const size_t index, const voyx::vector<s
 
   std::copy(
     buffer.output.begin() - synthesis_window_size + analysis_window_size,
-    buffer.output.end() - synthesis_window_size,
+    buffer.output.begin() - synthesis_window_size + analysis_window_size + blocksize,
     output.begin());
 
   std::copy(
-    buffer.output.begin() + synthesis_window_size,
+    buffer.output.begin() + blocksize,
     buffer.output.end(),
     buffer.output.begin());
 
@@ -15,9 +15,12 @@ class StftPitchShiftPipeline : public SyncPipeline<>
 public:
 
   StftPitchShiftPipeline(const double samplerate, const size_t framesize, const size_t hopsize, const size_t dftsize,
+                         const std::vector<double>& factors, const double quefrency,
                          std::shared_ptr<Source<sample_t>> source, std::shared_ptr<Sink<sample_t>> sink,
                          std::shared_ptr<MidiObserver> midi, std::shared_ptr<Plot> plot);
 
+  size_t latency() const override;
+
 protected:
 
   void operator()(const size_t index,
@@ -29,16 +32,17 @@ private:
   const double samplerate;
   const std::tuple<size_t, size_t> framesize;
   const size_t hopsize;
+  const size_t blocksize;
 
   struct
   {
-    std::vector<double> input;
-    std::vector<double> output;
+    std::vector<phasor_t::value_type> input;
+    std::vector<phasor_t::value_type> output;
   }
   buffer;
 
-  std::shared_ptr<stftpitchshift::STFT<double>> stft;
-  std::shared_ptr<stftpitchshift::StftPitchShiftCore<double>> core;
+  std::shared_ptr<stftpitchshift::STFT<phasor_t::value_type>> stft;
+  std::shared_ptr<stftpitchshift::StftPitchShiftCore<phasor_t::value_type>> core;
 
   std::shared_ptr<MidiObserver> midi;
   std::shared_ptr<Plot> plot;
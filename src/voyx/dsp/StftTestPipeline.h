@@ -6,7 +6,7 @@
 #include <voyx/io/MidiObserver.h>
 #include <voyx/ui/Plot.h>
 
-class StftTestPipeline : public StftPipeline<double>
+class StftTestPipeline : public StftPipeline<>
 {
 
 public:
@@ -21,7 +21,7 @@ public:
 
 private:
 
-  Vocoder<double> vocoder;
+  Vocoder<phasor_t::value_type> vocoder;
 
   std::shared_ptr<MidiObserver> midi;
   std::shared_ptr<Plot> plot;
@@ -1,7 +1,10 @@
 #pragma once
 
 #include <voyx/Header.h>
+#include <voyx/etc/Heap.h>
 #include <voyx/etc/Logger.h>
+#include <voyx/etc/Profiler.h>
+#include <voyx/etc/Realtime.h>
 #include <voyx/etc/Timer.h>
 #include <voyx/dsp/Pipeline.h>
 
@@ -16,12 +19,29 @@ public:
   {
   }
 
+  /**
+   * Processes a single frame in the calling thread without involving the source and sink,
+   * e.g. one channel of a MultichannelPipeline.
+   **/
+  void process(const size_t index, const voyx::vector<T> input, voyx::vector<T> output)
+  {
+    (*this)(index, input, output);
+  }
+
 protected:
 
   void onstart(const size_t frames, const std::chrono::duration<double> timeout) override
   {
     doloop = true;
 
+    // an offline render blocks anyway, so it runs in the calling thread,
+    // e.g. a ParallelRenderer worker, instead of a thread of its own
+    if (this->offline)
+    {
+      loop(frames, timeout);
+      return;
+    }
+
     thread = std::make_shared<std::thread>(
       [frames, timeout, this](){ loop(frames, timeout); });
 
@@ -53,19 +73,108 @@ protected:
 
 private:
 
+  struct Timers
+  {
+    Timer<std::chrono::milliseconds> inner;
+    Timer<std::chrono::milliseconds> outer;
+    Timer<std::chrono::milliseconds> latency;
+  };
+
+  Timers timers;
+  Timers totals;
+
   std::shared_ptr<std::thread> thread;
   bool doloop = false;
 
+  std::vector<std::pair<std::string, const Timer<std::chrono::milliseconds>*>> statistics() const override
+  {
+    return
+    {
+      { "inner", &totals.inner },
+      { "outer", &totals.outer },
+      { "latency", &totals.latency }
+    };
+  }
+
+  /**
+   * Returns the current input to output delay in seconds,
+   * as far as it is caused by buffering and processing.
+   **/
+  std::chrono::duration<double> roundtrip() const
+  {
+    const size_t samples =
+      this->source->latency() +
+      this->latency() +
+      this->sink->latency();
+
+    return std::chrono::duration<double>(samples / this->source->samplerate());
+  }
+
+  /**
+   * Reports heap allocations within the pipeline callback,
+   * which are only tracked in debug builds.
+   **/
+  static void heapcheck()
+  {
+    const size_t allocations = Heap::allocations();
+
+    if (allocations > 0)
+    {
+      LOG(WARNING)
+        << "Detected " << allocations
+        << " heap allocations in the real-time path!";
+    }
+  }
+
+  /**
+   * Logs the timings since the last report
+   * and accumulates them for the final statistics.
+   **/
+  void report()
+  {
+    std::ostringstream latency;
+
+    if (timers.latency.count())
+    {
+      latency << "\t" << "latency " << timers.latency.str();
+    }
+
+    LOG(INFO)
+      << "Timing: \t"
+      << "inner " << timers.inner.str() << "\t"
+      << "outer " << timers.outer.str()
+      << latency.str();
+
+    heapcheck();
+
+    totals.inner.merge(timers.inner);
+    totals.outer.merge(timers.outer);
+    totals.latency.merge(timers.latency);
+
+    timers.inner.cls();
+    timers.outer.cls();
+    timers.latency.cls();
+  }
+
   void loop(const size_t frames, const std::chrono::duration<double> timeout)
   {
-    struct
+    // an offline render has no deadlines and must not promote the calling thread
+    if (!this->offline)
     {
-      Timer<std::chrono::milliseconds> inner;
-      Timer<std::chrono::milliseconds> outer;
+      Realtime::promote("sync pipeline");
     }
-    timers;
 
-    std::vector<T> output(this->sink->framesize());
+    // the processing time must not exceed the frame period
+    const auto period = std::chrono::duration<double>(
+      this->source->framesize() / this->source->samplerate());
+
+    for (Timers* each : { &timers, &totals })
+    {
+      each->inner.cls();
+      each->outer.cls();
+      each->latency.cls();
+      each->inner.deadline(period);
+    }
 
     size_t index = 0;
     bool ok = true;
@@ -74,39 +183,52 @@ private:
 
     if (frames > 0)
     {
-      while (doloop && index < frames)
+      const auto timestamp = std::chrono::steady_clock::now();
+
+      // an offline render neither waits for the sink nor sleeps,
+      // but flushes the latency through additional silent frames
+      const size_t total = frames + this->lookahead();
+
+      while (doloop && index < total)
       {
-        ok = this->source->read(index, [&](const voyx::vector<T> input)
+        ok = this->pad(index, [&](const voyx::vector<T> input)
         {
           timers.outer.toc();
           timers.outer.tic();
 
-          timers.inner.tic();
-          (*this)(index, input, output);
-          timers.inner.toc();
+          auto process = [&](voyx::vector<T> output)
+          {
+            timers.inner.tic();
+            {
+              Heap::Realtime realtime;
+              (*this)(index, input, output);
+            }
+            timers.inner.toc();
+          };
+
+          if (this->offline)
+          {
+            this->trim(index, process);
+          }
+          else
+          {
+            this->sink->sync();
+            this->sink->write(index, process);
+          }
         });
 
-        if (ok)
-        {
-          this->sink->sync();
-          this->sink->write(index, output);
-        }
-
         index += ok ? 1 : 0;
 
-        if (timeout != std::chrono::duration<double>::zero())
+        if (!this->offline && timeout != std::chrono::duration<double>::zero())
         {
           std::this_thread::sleep_for(timeout);
         }
       }
 
-      LOG(INFO)
-        << "Timing: \t"
-        << "inner " << timers.inner.str() << "\t"
-        << "outer " << timers.outer.str();
+      report();
 
-      timers.inner.cls();
-      timers.outer.cls();
+      Pipeline<T>::throughput(std::min(index, frames),
+        this->source->framesize(), this->source->samplerate(), timestamp);
     }
     else
     {
@@ -126,13 +248,7 @@ private:
       {
         if (millis(now() - timestamp) > 5000)
         {
-          LOG(INFO)
-            << "Timing: \t"
-            << "inner " << timers.inner.str() << "\t"
-            << "outer " << timers.outer.str();
-
-          timers.inner.cls();
-          timers.outer.cls();
+          report();
 
           timestamp = now();
         }
@@ -142,16 +258,19 @@ private:
           timers.outer.toc();
           timers.outer.tic();
 
-          timers.inner.tic();
-          (*this)(index, input, output);
-          timers.inner.toc();
-        });
-
-        if (ok)
-        {
           this->sink->sync();
-          this->sink->write(index, output);
-        }
+          this->sink->write(index, [&](voyx::vector<T> output)
+          {
+            timers.inner.tic();
+            {
+              Heap::Realtime realtime;
+              (*this)(index, input, output);
+            }
+            timers.inner.toc();
+          });
+
+          timers.latency.add(roundtrip());
+        });
 
         index += ok ? 1 : 0;
 
@@ -160,6 +279,8 @@ private:
           std::this_thread::sleep_for(timeout);
         }
       }
+
+      report();
     }
   }
 
@@ -3,17 +3,24 @@
 #include <voyx/Source.h>
 
 VoiceSynthPipeline::VoiceSynthPipeline(const double samplerate, const size_t framesize, const size_t hopsize, const size_t dftsize,
+                                       const std::vector<double>& factors, const double quefrency,
                                        std::shared_ptr<Source<sample_t>> source, std::shared_ptr<Sink<sample_t>> sink,
-                                       std::shared_ptr<MidiObserver> midi, std::shared_ptr<Plot> plot) :
+                                       std::shared_ptr<MidiObserver> midi, std::shared_ptr<Plot> plot,
+                                       std::shared_ptr<ChannelLink> link, const size_t channel) :
   StftPipeline(samplerate, framesize, hopsize, dftsize, source, sink),
   vocoder(samplerate, framesize, hopsize, dftsize),
-  lifter(1e-3, samplerate, dftsize * 2 - 2),
   midi(midi),
   plot(plot)
 {
-  if (midi != nullptr)
-  {
-  }
+  effect = std::make_shared<FormantEffect>(
+    samplerate, dftsize, quefrency,
+    std::vector<std::shared_ptr<Effect>>
+    {
+      std::make_shared<PitchShiftEffect>(samplerate, dftsize, factors)
+    },
+    link, channel);
+
+  effect->reserve(hops());
 
   if (plot != nullptr)
   {
@@ -23,6 +30,13 @@ VoiceSynthPipeline::VoiceSynthPipeline(const double samplerate, const size_t fra
   }
 }
 
+void VoiceSynthPipeline::parallelize(std::shared_ptr<ThreadPool> pool)
+{
+  StftPipeline::parallelize(pool);
+
+  effect->parallelize(pool);
+}
+
 void VoiceSynthPipeline::operator()(const size_t index,
                                     const voyx::vector<sample_t> signal,
                                     voyx::matrix<phasor_t> dfts)
@@ -40,48 +54,15 @@ void VoiceSynthPipeline::operator()(const size_t index,
     plot->plot(abs);
   }
 
-  vocoder.encode(dfts);
-
-  const std::vector<double> factors = { 0.5, 1.25, 1.5, 2 };
-
-  const double roi[] = { 0, samplerate / 2 };
-
-  std::vector<double> envelope(dfts.stride());
-
-  lifter.lowpass<$$::real>(dfts.front(), envelope);
-
-  std::vector<phasor_t> buffer(factors.size() * dfts.stride());
-  voyx::matrix<phasor_t> buffers(buffer, dfts.stride());
-
-  for (auto dft : dfts)
   {
-    lifter.divide<$$::real>(dft, envelope);
-
-    for (size_t i = 0; i < factors.size(); ++i)
-    {
-      $$::interp(dft, buffers[i], factors[i]);
-    }
-
-    const auto mask = $$::argmax<$$::real>(buffers);
-
-    for (size_t i = 0; i < dft.size(); ++i)
-    {
-      const size_t j = mask[i];
-
-      dft[i] = buffers(j, i);
-
-      const auto frequency = dft[i].imag() * factors[j];
+    VOYXZONE("encode");
+    vocoder.encode(dfts);
+  }
 
-      dft[i].imag(frequency);
+  (*effect)(index, dfts);
 
-      if (frequency <= roi[0] || roi[1] <= frequency)
-      {
-        dft[i].real(0);
-      }
-    }
-
-    lifter.multiply<$$::real>(dft, envelope);
+  {
+    VOYXZONE("decode");
+    vocoder.decode(dfts);
   }
-
-  vocoder.decode(dfts);
 }
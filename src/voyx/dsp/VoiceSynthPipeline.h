@@ -1,20 +1,31 @@
 #pragma once
 
 #include <voyx/Header.h>
-#include <voyx/alg/Lifter.h>
 #include <voyx/alg/Vocoder.h>
+#include <voyx/dsp/ChannelLink.h>
 #include <voyx/dsp/StftPipeline.h>
+#include <voyx/fx/FormantEffect.h>
+#include <voyx/fx/PitchShiftEffect.h>
 #include <voyx/io/MidiObserver.h>
 #include <voyx/ui/Plot.h>
 
+/**
+ * Formant preserving multi-factor pitch shift,
+ * i.e. the PitchShiftEffect wrapped by the FormantEffect
+ * plus an optional spectrum plot.
+ **/
 class VoiceSynthPipeline : public StftPipeline<>
 {
 
 public:
 
   VoiceSynthPipeline(const double samplerate, const size_t framesize, const size_t hopsize, const size_t dftsize,
+                     const std::vector<double>& factors, const double quefrency,
                      std::shared_ptr<Source<sample_t>> source, std::shared_ptr<Sink<sample_t>> sink,
-                     std::shared_ptr<MidiObserver> midi, std::shared_ptr<Plot> plot);
+                     std::shared_ptr<MidiObserver> midi, std::shared_ptr<Plot> plot,
+                     std::shared_ptr<ChannelLink> link = nullptr, const size_t channel = 0);
+
+  void parallelize(std::shared_ptr<ThreadPool> pool) override;
 
   void operator()(const size_t index,
                   const voyx::vector<sample_t> signal,
@@ -22,10 +33,11 @@ public:
 
 private:
 
-  Vocoder<double> vocoder;
-  Lifter<double> lifter;
+  Vocoder<phasor_t::value_type> vocoder;
 
   std::shared_ptr<MidiObserver> midi;
   std::shared_ptr<Plot> plot;
 
+  std::shared_ptr<FormantEffect> effect;
+
 };
@@ -98,18 +98,16 @@ namespace $$
   // TODO: use xtensor
 
   template<typename value_getter_t, typename T>
-  std::vector<size_t> argmax(const voyx::matrix<T> matrix, const size_t axis = 0)
+  void argmax(const voyx::matrix<T> matrix, voyx::vector<size_t> indices, const size_t axis = 0)
   {
     using value_t = typename $$::typeofvalue<T>::type;
     const value_getter_t getvalue;
 
     static_assert(std::is_arithmetic<value_t>::value);
 
-    std::vector<size_t> indices;
-
     if (matrix.empty())
     {
-      return indices;
+      return;
     }
 
     const size_t shape[] =
@@ -120,7 +118,7 @@ namespace $$
 
     if (axis == 0)
     {
-      indices.resize(shape[1]);
+      voyxassert(indices.size() == shape[1]);
 
       for (size_t i = 0; i < shape[1]; ++i)
       {
@@ -141,7 +139,7 @@ namespace $$
     }
     else if (axis == 1)
     {
-      indices.resize(shape[0]);
+      voyxassert(indices.size() == shape[0]);
 
       for (size_t i = 0; i < shape[0]; ++i)
       {
@@ -164,7 +162,60 @@ namespace $$
     {
       throw std::runtime_error("Invalid axis index!");
     }
+  }
+
+  template<typename value_getter_t, typename T>
+  std::vector<size_t> argmax(const voyx::matrix<T> matrix, const size_t axis = 0)
+  {
+    std::vector<size_t> indices;
+
+    if (matrix.empty())
+    {
+      return indices;
+    }
+
+    indices.resize((axis == 0) ? matrix.stride() : matrix.size());
+
+    $$::argmax<value_getter_t>(matrix, indices, axis);
 
     return indices;
   }
+
+  /**
+   * Splits interleaved samples into one matrix row per channel.
+   **/
+  template<typename T>
+  void deinterleave(const T* samples, voyx::matrix<T> channels)
+  {
+    const size_t size = channels.size();
+
+    for (size_t i = 0; i < size; ++i)
+    {
+      auto channel = channels[i];
+
+      for (size_t j = 0; j < channel.size(); ++j)
+      {
+        channel[j] = samples[j * size + i];
+      }
+    }
+  }
+
+  /**
+   * Merges one matrix row per channel into interleaved samples.
+   **/
+  template<typename T>
+  void interleave(const voyx::matrix<T> channels, T* samples)
+  {
+    const size_t size = channels.size();
+
+    for (size_t i = 0; i < size; ++i)
+    {
+      const auto channel = channels[i];
+
+      for (size_t j = 0; j < channel.size(); ++j)
+      {
+        samples[j * size + i] = channel[j];
+      }
+    }
+  }
 }
@@ -6,6 +6,27 @@
 
 namespace $$
 {
+  /**
+   * Allocation free variant, which writes the product into the preallocated output.
+   **/
+  template<typename T>
+  void hpsmul(const voyx::vector<T> vector, voyx::vector<T> product, const size_t depth, const T empty = 0)
+  {
+    voyxassert(product.size() == vector.size());
+
+    std::copy(vector.begin(), vector.end(), product.begin());
+
+    for (size_t step = 2; step < depth + 2; ++step)
+    {
+      for (size_t i = 0; i < vector.size(); ++i)
+      {
+        const size_t j = i * step;
+
+        product[i] /* multiply */ *= (j < vector.size()) ? vector[j] : empty;
+      }
+    }
+  }
+
   template<typename T>
   std::vector<T> hpsmul(const std::vector<T>& vector, const size_t depth, const T empty = 0)
   {
@@ -0,0 +1,113 @@
+#include <voyx/etc/EventLog.h>
+
+#include <voyx/Source.h>
+
+EventLog::EventLog(const std::string& name, const size_t capacity, const std::chrono::milliseconds interval) :
+  name(name),
+  interval(interval),
+  events(capacity),
+  overflows(0),
+  doloop(true)
+{
+  for (auto& counter : counters)
+  {
+    counter = 0;
+  }
+
+  thread = std::thread([this]() { loop(); });
+}
+
+EventLog::~EventLog()
+{
+  {
+    std::lock_guard lock(mutex);
+    doloop = false;
+  }
+
+  condition.notify_all();
+
+  if (thread.joinable())
+  {
+    thread.join();
+  }
+}
+
+void EventLog::push(const Code code, const size_t a, const size_t b)
+{
+  counters[static_cast<size_t>(code)].fetch_add(1, std::memory_order_relaxed);
+
+  if (!events.try_enqueue({ code, a, b }))
+  {
+    overflows.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+size_t EventLog::count(const Code code) const
+{
+  return counters[static_cast<size_t>(code)].load(std::memory_order_relaxed);
+}
+
+size_t EventLog::dropped() const
+{
+  return overflows.load(std::memory_order_relaxed);
+}
+
+void EventLog::loop()
+{
+  size_t reported = 0;
+
+  std::unique_lock lock(mutex);
+
+  while (true)
+  {
+    const bool stop = condition.wait_for(lock, interval, [this]() { return !doloop; });
+
+    drain();
+
+    const size_t overflows = dropped();
+
+    if (overflows > reported)
+    {
+      LOG(WARNING) << $("{0} event log dropped {1} events!",
+                        name, overflows - reported);
+
+      reported = overflows;
+    }
+
+    if (stop)
+    {
+      break;
+    }
+  }
+}
+
+void EventLog::drain()
+{
+  Event event;
+
+  while (events.try_dequeue(event))
+  {
+    LOG(WARNING) << str(event);
+  }
+}
+
+std::string EventLog::str(const Event& event) const
+{
+  switch (event.code)
+  {
+  case Code::FifoOverflow:
+    return $("{0} fifo overflow!", name);
+  case Code::FifoUnderflow:
+    return $("{0} fifo underflow!", name);
+  case Code::StreamOverflow:
+    return $("{0} stream overflow!", name);
+  case Code::StreamUnderflow:
+    return $("{0} stream underflow!", name);
+  case Code::StreamStatus:
+    return $("{0} stream status {1}!", name, event.a);
+  case Code::FrameSize:
+    return $("{0} frame size {1} != {2}!", name, event.a, event.b);
+  default:
+    return $("{0} event {1}!", name, static_cast<size_t>(event.code));
+  }
+}
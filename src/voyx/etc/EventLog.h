@@ -0,0 +1,74 @@
+#pragma once
+
+#include <voyx/Header.h>
+
+#include <readerwriterqueue.h>
+
+/**
+ * Real-time safe diagnostics for audio callbacks.
+ *
+ * The audio thread only pushes typed events into a preallocated
+ * lock-free ring and bumps the corresponding counters,
+ * while a background thread formats and forwards them to the logger.
+ *
+ * Each instance expects a single producer thread.
+ **/
+class EventLog
+{
+
+public:
+
+  enum class Code : size_t
+  {
+    FifoOverflow,
+    FifoUnderflow,
+    StreamOverflow,
+    StreamUnderflow,
+    StreamStatus,
+    FrameSize,
+    Count
+  };
+
+  EventLog(const std::string& name,
+           const size_t capacity = 1024,
+           const std::chrono::milliseconds interval = std::chrono::milliseconds(100));
+
+  ~EventLog();
+
+  /**
+   * Wait-free, so it can be called from within audio callbacks.
+   **/
+  void push(const Code code, const size_t a = 0, const size_t b = 0);
+
+  size_t count(const Code code) const;
+  size_t dropped() const;
+
+private:
+
+  struct Event
+  {
+    Code code;
+    size_t a;
+    size_t b;
+  };
+
+  const std::string name;
+  const std::chrono::milliseconds interval;
+
+  moodycamel::ReaderWriterQueue<Event> events;
+
+  std::array<std::atomic<size_t>, static_cast<size_t>(Code::Count)> counters;
+  std::atomic<size_t> overflows;
+
+  std::thread thread;
+  bool doloop;
+
+  std::mutex mutex;
+  std::condition_variable condition;
+
+  void loop();
+  void drain();
+
+  std::string str(const Event& event) const;
+
+};
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <voyx/Header.h>
+
+namespace voyx
+{
+  template<typename F>
+  class function_ref;
+
+  /**
+   * Non-owning reference to a callable, similar to std::function_ref.
+   *
+   * In contrast to std::function it never allocates and consists of just
+   * two pointers, so it is suitable for per-frame callbacks passed through
+   * virtual functions. The referenced callable must outlive the reference.
+   **/
+  template<typename R, typename... Args>
+  class function_ref<R(Args...)>
+  {
+
+  public:
+
+    template<typename F>
+    requires (!std::is_same_v<std::remove_cvref_t<F>, function_ref> &&
+              std::is_invocable_r_v<R, F&, Args...>)
+    function_ref(F&& callable) noexcept :
+      object(const_cast<void*>(static_cast<const void*>(std::addressof(callable)))),
+      callback([](void* object, Args... args) -> R
+      {
+        return std::invoke(
+          *static_cast<std::add_pointer_t<std::remove_reference_t<F>>>(object),
+          std::forward<Args>(args)...);
+      })
+    {
+    }
+
+    function_ref(const function_ref& other) = default;
+    function_ref& operator=(const function_ref& other) = default;
+
+    R operator()(Args... args) const
+    {
+      return callback(object, std::forward<Args>(args)...);
+    }
+
+  private:
+
+    void* object;
+    R (*callback)(void* object, Args... args);
+
+  };
+}
@@ -0,0 +1,240 @@
+#include <voyx/etc/Heap.h>
+
+#include <new>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+#ifndef NDEBUG
+
+static thread_local size_t depth = 0;
+static std::atomic<size_t> counter = 0;
+
+static void count()
+{
+  if (depth)
+  {
+    counter.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+static void* allocate(const std::size_t size)
+{
+  count();
+
+  return std::malloc(size ? size : 1);
+}
+
+static void* allocate(const std::size_t size, const std::align_val_t alignment)
+{
+  count();
+
+  const std::size_t align = static_cast<std::size_t>(alignment);
+
+  #ifdef _WIN32
+  return _aligned_malloc(size ? size : 1, align);
+  #else
+  // the size must be a multiple of the alignment
+  return std::aligned_alloc(align, ((size ? size : 1) + align - 1) / align * align);
+  #endif
+}
+
+static void deallocate(void* pointer)
+{
+  std::free(pointer);
+}
+
+static void deallocate(void* pointer, const std::align_val_t)
+{
+  #ifdef _WIN32
+  _aligned_free(pointer);
+  #else
+  std::free(pointer);
+  #endif
+}
+
+template<typename... Args>
+static void* allocate_or_throw(Args... args)
+{
+  void* pointer = allocate(args...);
+
+  if (pointer == nullptr)
+  {
+    throw std::bad_alloc();
+  }
+
+  return pointer;
+}
+
+void* operator new(std::size_t size)
+{
+  return allocate_or_throw(size);
+}
+
+void* operator new[](std::size_t size)
+{
+  return allocate_or_throw(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+  return allocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+  return allocate(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+  return allocate_or_throw(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+  return allocate_or_throw(size, alignment);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+  return allocate(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+  return allocate(size, alignment);
+}
+
+void operator delete(void* pointer) noexcept
+{
+  deallocate(pointer);
+}
+
+void operator delete[](void* pointer) noexcept
+{
+  deallocate(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+  deallocate(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept
+{
+  deallocate(pointer);
+}
+
+void operator delete(void* pointer, const std::nothrow_t&) noexcept
+{
+  deallocate(pointer);
+}
+
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept
+{
+  deallocate(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t alignment) noexcept
+{
+  deallocate(pointer, alignment);
+}
+
+void operator delete[](void* pointer, std::align_val_t alignment) noexcept
+{
+  deallocate(pointer, alignment);
+}
+
+void operator delete(void* pointer, std::size_t, std::align_val_t alignment) noexcept
+{
+  deallocate(pointer, alignment);
+}
+
+void operator delete[](void* pointer, std::size_t, std::align_val_t alignment) noexcept
+{
+  deallocate(pointer, alignment);
+}
+
+void operator delete(void* pointer, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+  deallocate(pointer, alignment);
+}
+
+void operator delete[](void* pointer, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+  deallocate(pointer, alignment);
+}
+
+Heap::Realtime::Realtime()
+{
+  ++depth;
+}
+
+Heap::Realtime::~Realtime()
+{
+  --depth;
+}
+
+Heap::Exempt::Exempt() :
+  suspended(depth)
+{
+  depth = 0;
+}
+
+Heap::Exempt::~Exempt()
+{
+  depth = suspended;
+}
+
+bool Heap::enabled()
+{
+  return true;
+}
+
+bool Heap::realtime()
+{
+  return depth > 0;
+}
+
+size_t Heap::allocations()
+{
+  return counter.exchange(0, std::memory_order_relaxed);
+}
+
+#else
+
+Heap::Realtime::Realtime()
+{
+}
+
+Heap::Realtime::~Realtime()
+{
+}
+
+Heap::Exempt::Exempt() :
+  suspended(0)
+{
+}
+
+Heap::Exempt::~Exempt()
+{
+}
+
+bool Heap::enabled()
+{
+  return false;
+}
+
+bool Heap::realtime()
+{
+  return false;
+}
+
+size_t Heap::allocations()
+{
+  return 0;
+}
+
+#endif
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <voyx/Header.h>
+
+/**
+ * Heap allocation tracker for the real-time path.
+ *
+ * In debug builds (without NDEBUG) all variants of the global operator new,
+ * including the aligned and nothrow ones, count every allocation
+ * which happens on a thread inside a Heap::Realtime scope.
+ * In release builds the scope is a no-op and the counter remains zero.
+ **/
+struct Heap
+{
+  /**
+   * Marks the current thread as real-time for the lifetime of this object.
+   **/
+  struct Realtime
+  {
+    Realtime();
+    ~Realtime();
+
+    Realtime(const Realtime&) = delete;
+    Realtime& operator=(const Realtime&) = delete;
+  };
+
+  /**
+   * Suspends the tracking of the current thread for the lifetime of this object,
+   * e.g. around a third party call which is known to allocate.
+   **/
+  struct Exempt
+  {
+    Exempt();
+    ~Exempt();
+
+    Exempt(const Exempt&) = delete;
+    Exempt& operator=(const Exempt&) = delete;
+
+  private:
+
+    size_t suspended;
+  };
+
+  static bool enabled();
+
+  /**
+   * Returns true if the current thread is inside a Heap::Realtime scope,
+   * e.g. to extend the scope to worker threads.
+   **/
+  static bool realtime();
+
+  /**
+   * Returns the number of real-time allocations since the last call.
+   **/
+  static size_t allocations();
+};
@@ -0,0 +1,124 @@
+#include <voyx/etc/Profiler.h>
+
+#include <voyx/Source.h>
+
+struct Event
+{
+  const Profiler::Stage* stage;
+  size_t thread;
+  std::chrono::steady_clock::time_point begin;
+  std::chrono::steady_clock::time_point end;
+};
+
+static std::atomic<Profiler::Stage*> stages = nullptr;
+static std::atomic<size_t> threads = 0;
+
+static struct
+{
+  std::unique_ptr<Event[]> events;
+  size_t capacity = 0;
+  std::atomic<size_t> cursor = 0;
+  std::chrono::steady_clock::time_point epoch;
+}
+tracer;
+
+Profiler::Stage::Stage(const char* name) :
+  name(name),
+  next(stages.load(std::memory_order_relaxed))
+{
+  while (!stages.compare_exchange_weak(next, this, std::memory_order_release, std::memory_order_relaxed)) {}
+}
+
+bool Profiler::enabled()
+{
+  #ifdef VOYXPROFILE
+  return true;
+  #else
+  return false;
+  #endif
+}
+
+void Profiler::trace(const size_t capacity)
+{
+  tracer.events = std::make_unique<Event[]>(capacity);
+  tracer.capacity = capacity;
+  tracer.cursor = 0;
+  tracer.epoch = std::chrono::steady_clock::now();
+}
+
+void Profiler::record(Stage& stage, const std::chrono::steady_clock::time_point begin, const std::chrono::steady_clock::time_point end)
+{
+  stage.timer.add(end - begin);
+
+  if (!tracer.capacity)
+  {
+    return;
+  }
+
+  const size_t index = tracer.cursor.fetch_add(1, std::memory_order_relaxed);
+
+  if (index >= tracer.capacity)
+  {
+    return;
+  }
+
+  static thread_local const size_t thread = threads.fetch_add(1, std::memory_order_relaxed);
+
+  tracer.events[index] = { &stage, thread, begin, end };
+}
+
+void Profiler::report()
+{
+  for (Stage* stage = stages.load(std::memory_order_acquire); stage != nullptr; stage = stage->next)
+  {
+    if (!stage->timer.count())
+    {
+      continue;
+    }
+
+    LOG(INFO)
+      << "Profile: \t"
+      << stage->name << " " << stage->timer.str() << "\t"
+      << "p90=" << stage->timer.percentile(90) << " "
+      << "p99.9=" << stage->timer.percentile(99.9);
+  }
+}
+
+void Profiler::dump(const std::string& path)
+{
+  std::ofstream file(path);
+
+  if (!file)
+  {
+    throw std::runtime_error("Unable to write " + path + "!");
+  }
+
+  auto micros = [](const std::chrono::steady_clock::duration& duration)
+  {
+    return std::chrono::duration<double, std::micro>(duration).count();
+  };
+
+  const size_t count = std::min(tracer.cursor.load(), tracer.capacity);
+
+  if (tracer.cursor.load() > tracer.capacity)
+  {
+    LOG(WARNING) << $("Dropped {0} of {1} trace events!",
+                      tracer.cursor.load() - tracer.capacity, tracer.cursor.load());
+  }
+
+  file << std::fixed << std::setprecision(3);
+  file << "{ \"traceEvents\": [" << std::endl;
+
+  for (size_t i = 0; i < count; ++i)
+  {
+    const Event& event = tracer.events[i];
+
+    file << "  { \"name\": \"" << event.stage->name << "\", \"ph\": \"X\", "
+         << "\"pid\": 0, \"tid\": " << event.thread << ", "
+         << "\"ts\": " << micros(event.begin - tracer.epoch) << ", "
+         << "\"dur\": " << micros(event.end - event.begin) << " }"
+         << (i + 1 < count ? "," : "") << std::endl;
+  }
+
+  file << "] }" << std::endl;
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <voyx/Header.h>
+#include <voyx/etc/Timer.h>
+
+/**
+ * Scoped profiling zones for the individual processing stages.
+ *
+ * Each VOYXZONE(name) measures the time until the end of the enclosing scope
+ * and aggregates it in a stage per call site, which registers itself once
+ * without any heap allocation. If tracing is enabled, each zone is recorded
+ * as Chrome trace event into a preallocated buffer as well.
+ *
+ * Unless compiled with VOYXPROFILE (see the PROFILE CMake option),
+ * the macro expands to nothing and thus has no runtime cost at all.
+ **/
+class Profiler
+{
+
+public:
+
+  struct Stage
+  {
+    Stage(const char* name);
+
+    const char* const name;
+    Timer<std::chrono::microseconds> timer;
+    Stage* next;
+  };
+
+  class Zone
+  {
+
+  public:
+
+    Zone(Stage& stage) :
+      stage(stage),
+      timestamp(std::chrono::steady_clock::now())
+    {
+    }
+
+    ~Zone()
+    {
+      Profiler::record(stage, timestamp, std::chrono::steady_clock::now());
+    }
+
+    Zone(const Zone&) = delete;
+    Zone& operator=(const Zone&) = delete;
+
+  private:
+
+    Stage& stage;
+    const std::chrono::steady_clock::time_point timestamp;
+
+  };
+
+  static bool enabled();
+
+  /**
+   * Enables the trace recording of up to the specified number of zones.
+   **/
+  static void trace(const size_t capacity);
+
+  static void record(Stage& stage, const std::chrono::steady_clock::time_point begin, const std::chrono::steady_clock::time_point end);
+
+  /**
+   * Logs the per stage statistics.
+   **/
+  static void report();
+
+  /**
+   * Writes the recorded zones as Chrome trace event .json file,
+   * which can be viewed in chrome://tracing or ui.perfetto.dev.
+   **/
+  static void dump(const std::string& path);
+
+};
+
+#ifdef VOYXPROFILE
+#define VOYXZONEID2(name, line) name##line
+#define VOYXZONEID(name, line) VOYXZONEID2(name, line)
+#define VOYXZONE(name) \
+  static Profiler::Stage VOYXZONEID(voyxstage, __LINE__)(name); \
+  const Profiler::Zone VOYXZONEID(voyxzone, __LINE__)(VOYXZONEID(voyxstage, __LINE__))
+#else
+#define VOYXZONE(name)
+#endif
@@ -0,0 +1,129 @@
+#include <voyx/etc/Realtime.h>
+
+#include <voyx/Source.h>
+
+#include <cerrno>
+#include <cstring>
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#define VOYXPOSIX
+#endif
+
+static Realtime::Options config;
+
+static std::string status(const int error)
+{
+  return error ? std::strerror(error) : "ok";
+}
+
+/**
+ * Touches the specified amount of stack memory once,
+ * which then remains resident because of mlockall.
+ **/
+static void prefault()
+{
+  constexpr size_t size = 128 * 1024;
+  constexpr size_t page = 4 * 1024;
+
+  volatile uint8_t stack[size];
+
+  for (size_t i = 0; i < size; i += page)
+  {
+    stack[i] = 0;
+  }
+}
+
+void Realtime::configure(const Options& options)
+{
+  config = options;
+
+  if (!enabled())
+  {
+    return;
+  }
+
+  #ifdef VOYXPOSIX
+
+  const int error = mlockall(MCL_CURRENT | MCL_FUTURE) ? errno : 0;
+
+  #else
+
+  const int error = ENOSYS;
+
+  #endif
+
+  if (error)
+  {
+    LOG(WARNING) << $("Realtime: memory lock {0}", status(error));
+  }
+  else
+  {
+    LOG(INFO) << $("Realtime: memory lock {0}", status(error));
+  }
+}
+
+bool Realtime::enabled()
+{
+  return config.priority > 0;
+}
+
+void Realtime::promote(const std::string& name, const size_t offset)
+{
+  if (!enabled())
+  {
+    return;
+  }
+
+  int priority = ENOSYS;
+  int affinity = ENOSYS;
+
+  const int cpu = (config.cpu < 0) ? config.cpu : static_cast<int>(
+    (config.cpu + offset) % std::max(std::thread::hardware_concurrency(), 1u));
+
+  #ifdef VOYXPOSIX
+
+  {
+    sched_param parameters = {};
+
+    parameters.sched_priority = std::clamp(config.priority,
+      sched_get_priority_min(SCHED_FIFO),
+      sched_get_priority_max(SCHED_FIFO));
+
+    priority = pthread_setschedparam(pthread_self(), SCHED_FIFO, &parameters);
+  }
+
+  #endif
+
+  #ifdef __linux__
+
+  if (cpu >= 0)
+  {
+    cpu_set_t cpus;
+
+    CPU_ZERO(&cpus);
+    CPU_SET(cpu, &cpus);
+
+    affinity = pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+  }
+
+  #endif
+
+  prefault();
+
+  const std::string report = $("Realtime {0}: priority {1} {2}, cpu {3} {4}, stack prefault ok",
+    name,
+    config.priority, status(priority),
+    cpu, cpu < 0 ? "any" : status(affinity));
+
+  if (priority || (cpu >= 0 && affinity))
+  {
+    LOG(WARNING) << report;
+  }
+  else
+  {
+    LOG(INFO) << report;
+  }
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <voyx/Header.h>
+
+/**
+ * Opt-in real-time setup for the DSP threads.
+ *
+ * Once configured, each pipeline thread promotes itself to SCHED_FIFO,
+ * optionally pins itself to the specified core and prefaults its stack,
+ * while the process memory is locked by mlockall, so that neither the
+ * scheduler nor the pager interrupts the real-time path.
+ *
+ * Missing permissions or platform support are not fatal,
+ * the achieved settings are just reported instead.
+ **/
+struct Realtime
+{
+  struct Options
+  {
+    int priority = 0; // SCHED_FIFO priority, 0 means disabled
+    int cpu = -1;     // core to pin the DSP thread to, -1 means any
+  };
+
+  /**
+   * Stores the options and locks the current and future process memory.
+   **/
+  static void configure(const Options& options);
+
+  static bool enabled();
+
+  /**
+   * Applies the configured priority and affinity to the calling thread
+   * and prefaults its stack. The optional core offset spreads a group
+   * of threads over consecutive cores, e.g. the scheduler workers.
+   **/
+  static void promote(const std::string& name, const size_t offset = 0);
+};
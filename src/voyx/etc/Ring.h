@@ -0,0 +1,167 @@
+#pragma once
+
+#include <voyx/Header.h>
+
+/**
+ * Lock-free single producer single consumer ring buffer
+ * with sample granular reads and writes.
+ *
+ * Both indices grow monotonically and reside in separate cache lines,
+ * so the producer and consumer threads don't invalidate each other's
+ * index on every access.
+ **/
+template<typename T>
+class Ring
+{
+
+public:
+
+  Ring(const size_t capacity) :
+    buffer(capacity)
+  {
+    voyxassert(capacity > 0);
+  }
+
+  size_t capacity() const
+  {
+    return buffer.size();
+  }
+
+  /**
+   * Returns the number of readable elements.
+   **/
+  size_t size() const
+  {
+    return head.value.load(std::memory_order_acquire) -
+           tail.value.load(std::memory_order_acquire);
+  }
+
+  /**
+   * Returns the number of writable elements.
+   **/
+  size_t space() const
+  {
+    return capacity() - size();
+  }
+
+  /**
+   * Copies the specified number of elements into the ring,
+   * but only if there is enough space for all of them.
+   **/
+  bool write(const T* data, const size_t size)
+  {
+    const size_t head = this->head.value.load(std::memory_order_relaxed);
+    const size_t tail = this->tail.value.load(std::memory_order_acquire);
+
+    if (capacity() - (head - tail) < size)
+    {
+      return false;
+    }
+
+    const size_t offset = head % capacity();
+    const size_t first = std::min(size, capacity() - offset);
+
+    std::copy(data, data + first, buffer.data() + offset);
+    std::copy(data + first, data + size, buffer.data());
+
+    this->head.value.store(head + size, std::memory_order_release);
+
+    return true;
+  }
+
+  /**
+   * Copies the specified number of elements out of the ring,
+   * but only if there are enough readable elements.
+   **/
+  bool read(T* data, const size_t size)
+  {
+    const size_t tail = this->tail.value.load(std::memory_order_relaxed);
+    const size_t head = this->head.value.load(std::memory_order_acquire);
+
+    if (head - tail < size)
+    {
+      return false;
+    }
+
+    const size_t offset = tail % capacity();
+    const size_t first = std::min(size, capacity() - offset);
+
+    std::copy(buffer.data() + offset, buffer.data() + offset + first, data);
+    std::copy(buffer.data(), buffer.data() + size - first, data + first);
+
+    this->tail.value.store(tail + size, std::memory_order_release);
+
+    return true;
+  }
+
+  /**
+   * Lets the callback fill the next writable elements in place.
+   *
+   * The region must not wrap around, which is the case if the capacity
+   * is a multiple of the region size and the producer always writes
+   * regions of the same size.
+   **/
+  template<typename F>
+  bool write(const size_t size, F&& callback)
+  {
+    const size_t head = this->head.value.load(std::memory_order_relaxed);
+    const size_t tail = this->tail.value.load(std::memory_order_acquire);
+
+    if (capacity() - (head - tail) < size)
+    {
+      return false;
+    }
+
+    const size_t offset = head % capacity();
+
+    voyxassert(offset + size <= capacity());
+
+    callback(voyx::vector<T>(buffer.data() + offset, size));
+
+    this->head.value.store(head + size, std::memory_order_release);
+
+    return true;
+  }
+
+  /**
+   * Lets the callback consume the next readable elements in place.
+   *
+   * The region must not wrap around, which is the case if the capacity
+   * is a multiple of the region size and the consumer always reads
+   * regions of the same size.
+   **/
+  template<typename F>
+  bool read(const size_t size, F&& callback)
+  {
+    const size_t tail = this->tail.value.load(std::memory_order_relaxed);
+    const size_t head = this->head.value.load(std::memory_order_acquire);
+
+    if (head - tail < size)
+    {
+      return false;
+    }
+
+    const size_t offset = tail % capacity();
+
+    voyxassert(offset + size <= capacity());
+
+    callback(voyx::vector<T>(buffer.data() + offset, size));
+
+    this->tail.value.store(tail + size, std::memory_order_release);
+
+    return true;
+  }
+
+private:
+
+  struct alignas(64) Index
+  {
+    std::atomic<size_t> value = 0;
+  };
+
+  Index head;
+  Index tail;
+
+  std::vector<T> buffer;
+
+};
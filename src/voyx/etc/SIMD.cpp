@@ -0,0 +1,252 @@
+#include <voyx/etc/SIMD.h>
+
+#include <voyx/Source.h>
+
+#if defined(__x86_64__) && defined(__linux__) && defined(__GNUC__)
+#define VOYXSIMD __attribute__((target_clones("avx512f", "avx2", "default")))
+#define VOYXSIMDX86
+#else
+#define VOYXSIMD
+#endif
+
+/**
+ * Branchless variant of the Vocoder::atan2 approximation.
+ **/
+template<typename T>
+static inline T approxatan2(const T y, const T x)
+{
+  const T a = T(0.596227);
+  const T b = std::abs(a * y * x);
+  const T c = b + y * y;
+  const T d = b + x * x;
+  const T e = (c + d) > 0 ? c / (c + d) : T(0);
+
+  const bool ys = y < 0;
+  const bool xs = x < 0;
+
+  const T q = (ys && !xs) ? T(4) : (xs ? T(2) : T(0));
+  const T phi = q + ((ys != xs) ? -e : e);
+
+  return phi * T(1.57079632679489661923);
+}
+
+/**
+ * Branchless sine and cosine approximation by Taylor polynomials
+ * after reducing the argument to the interval from -pi/4 to pi/4.
+ **/
+template<typename T>
+static inline void approxsincos(const T x, T& sin, T& cos)
+{
+  const T q = std::round(x * T(0.63661977236758134308));
+
+  // Cody-Waite reduction with pi/2 split into two parts
+  const T r = (x - q * T(1.57079632679489655800)) - q * T(6.12323399573676603587e-17);
+  const T rr = r * r;
+
+  const T s = r * (T(1) + rr * (T(-1) / 6 + rr * (T(1) / 120 + rr * (T(-1) / 5040 + rr * (T(1) / 362880 +
+              rr * (T(-1) / 39916800 + rr * (T(1) / 6227020800)))))));
+
+  const T c = T(1) + rr * (T(-1) / 2 + rr * (T(1) / 24 + rr * (T(-1) / 720 + rr * (T(1) / 40320 +
+              rr * (T(-1) / 3628800 + rr * (T(1) / 479001600 + rr * (T(-1) / 87178291200)))))));
+
+  // quadrant index from 0 to 3
+  const T k = q - T(4) * std::floor(q * T(0.25));
+
+  const bool swap = (k == T(1)) || (k == T(3));
+  const bool negsin = (k == T(2)) || (k == T(3));
+  const bool negcos = (k == T(1)) || (k == T(2));
+
+  sin = swap ? c : s;
+  cos = swap ? s : c;
+
+  sin = negsin ? -sin : sin;
+  cos = negcos ? -cos : cos;
+}
+
+/**
+ * Block copies instead of element-wise loops,
+ * since memmove is already vectorized by the runtime library.
+ **/
+template<typename T>
+static inline void blockshift(const size_t size, const size_t offset, T* x, const T* samples)
+{
+  std::copy(x + offset, x + size, x);
+
+  if (samples != nullptr)
+  {
+    std::copy(samples, samples + offset, x + size - offset);
+  }
+  else
+  {
+    std::fill(x + size - offset, x + size, T(0));
+  }
+}
+
+std::string SIMD::isa()
+{
+  #if defined(VOYXSIMDX86)
+  __builtin_cpu_init();
+
+  if (__builtin_cpu_supports("avx512f"))
+  {
+    return "avx512f";
+  }
+
+  if (__builtin_cpu_supports("avx2"))
+  {
+    return "avx2";
+  }
+
+  return "default";
+  #elif defined(__ARM_NEON)
+  return "neon";
+  #else
+  return "default";
+  #endif
+}
+
+VOYXSIMD void SIMD::multiply(const size_t size, const float* __restrict x, const float* __restrict y, float* __restrict z)
+{
+  for (size_t i = 0; i < size; ++i)
+  {
+    z[i] = x[i] * y[i];
+  }
+}
+
+VOYXSIMD void SIMD::multiply(const size_t size, const float* __restrict x, const float* __restrict y, double* __restrict z)
+{
+  for (size_t i = 0; i < size; ++i)
+  {
+    z[i] = x[i] * y[i];
+  }
+}
+
+VOYXSIMD void SIMD::multiply(const size_t size, const double* __restrict x, const double* __restrict y, double* __restrict z)
+{
+  for (size_t i = 0; i < size; ++i)
+  {
+    z[i] = x[i] * y[i];
+  }
+}
+
+VOYXSIMD void SIMD::multiplyadd(const size_t size, const float* __restrict x, const float* __restrict y, float* __restrict z)
+{
+  for (size_t i = 0; i < size; ++i)
+  {
+    z[i] += x[i] * y[i];
+  }
+}
+
+VOYXSIMD void SIMD::multiplyadd(const size_t size, const double* __restrict x, const float* __restrict y, float* __restrict z)
+{
+  for (size_t i = 0; i < size; ++i)
+  {
+    z[i] += x[i] * y[i];
+  }
+}
+
+VOYXSIMD void SIMD::multiplyadd(const size_t size, const double* __restrict x, const double* __restrict y, double* __restrict z)
+{
+  for (size_t i = 0; i < size; ++i)
+  {
+    z[i] += x[i] * y[i];
+  }
+}
+
+void SIMD::shift(const size_t size, const size_t offset, float* x, const float* samples)
+{
+  blockshift(size, offset, x, samples);
+}
+
+void SIMD::shift(const size_t size, const size_t offset, double* x, const double* samples)
+{
+  blockshift(size, offset, x, samples);
+}
+
+VOYXSIMD void SIMD::wrap(const size_t size, float* x)
+{
+  float* __restrict data = x;
+
+  const float pi = 2 * float(M_PI);
+
+  for (size_t i = 0; i < size; ++i)
+  {
+    data[i] -= pi * std::floor(data[i] / pi + 0.5f);
+  }
+}
+
+VOYXSIMD void SIMD::wrap(const size_t size, double* x)
+{
+  double* __restrict data = x;
+
+  const double pi = 2 * M_PI;
+
+  for (size_t i = 0; i < size; ++i)
+  {
+    data[i] -= pi * std::floor(data[i] / pi + 0.5);
+  }
+}
+
+VOYXSIMD void SIMD::absarg(const size_t size, std::complex<float>* z)
+{
+  float* __restrict data = reinterpret_cast<float*>(z);
+
+  for (size_t i = 0; i < size * 2; i += 2)
+  {
+    const float x = data[i];
+    const float y = data[i + 1];
+
+    data[i] = std::sqrt(x * x + y * y);
+    data[i + 1] = approxatan2(y, x);
+  }
+}
+
+VOYXSIMD void SIMD::absarg(const size_t size, std::complex<double>* z)
+{
+  double* __restrict data = reinterpret_cast<double*>(z);
+
+  for (size_t i = 0; i < size * 2; i += 2)
+  {
+    const double x = data[i];
+    const double y = data[i + 1];
+
+    data[i] = std::sqrt(x * x + y * y);
+    data[i + 1] = approxatan2(y, x);
+  }
+}
+
+VOYXSIMD void SIMD::polar(const size_t size, std::complex<float>* z)
+{
+  float* __restrict data = reinterpret_cast<float*>(z);
+
+  for (size_t i = 0; i < size * 2; i += 2)
+  {
+    const float r = data[i];
+    const float phi = data[i + 1];
+
+    float sin, cos;
+
+    approxsincos(phi, sin, cos);
+
+    data[i] = r * cos;
+    data[i + 1] = r * sin;
+  }
+}
+
+VOYXSIMD void SIMD::polar(const size_t size, std::complex<double>* z)
+{
+  double* __restrict data = reinterpret_cast<double*>(z);
+
+  for (size_t i = 0; i < size * 2; i += 2)
+  {
+    const double r = data[i];
+    const double phi = data[i + 1];
+
+    double sin, cos;
+
+    approxsincos(phi, sin, cos);
+
+    data[i] = r * cos;
+    data[i + 1] = r * sin;
+  }
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <voyx/Header.h>
+
+/**
+ * Vectorizable array kernels, which are compiled for multiple instruction sets
+ * and dispatched at runtime according to the detected CPU features.
+ **/
+struct SIMD
+{
+  static std::string isa();
+
+  /**
+   * z[i] = x[i] * y[i]
+   **/
+  static void multiply(const size_t size, const float* x, const float* y, float* z);
+  static void multiply(const size_t size, const float* x, const float* y, double* z);
+  static void multiply(const size_t size, const double* x, const double* y, double* z);
+
+  /**
+   * z[i] += x[i] * y[i]
+   **/
+  static void multiplyadd(const size_t size, const float* x, const float* y, float* z);
+  static void multiplyadd(const size_t size, const double* x, const float* y, float* z);
+  static void multiplyadd(const size_t size, const double* x, const double* y, double* z);
+
+  /**
+   * x[i] = x[i + offset] for i < size - offset,
+   * followed by the specified samples or zeros
+   **/
+  static void shift(const size_t size, const size_t offset, float* x, const float* samples = nullptr);
+  static void shift(const size_t size, const size_t offset, double* x, const double* samples = nullptr);
+
+  /**
+   * x[i] = x[i] wrapped to the interval from -pi to pi
+   **/
+  static void wrap(const size_t size, float* x);
+  static void wrap(const size_t size, double* x);
+
+  /**
+   * z[i] = { abs(z[i]), arg(z[i]) }
+   * using the Girones arctangent approximation
+   **/
+  static void absarg(const size_t size, std::complex<float>* z);
+  static void absarg(const size_t size, std::complex<double>* z);
+
+  /**
+   * z[i] = polar(z[i].real(), z[i].imag())
+   **/
+  static void polar(const size_t size, std::complex<float>* z);
+  static void polar(const size_t size, std::complex<double>* z);
+};
@@ -0,0 +1,229 @@
+#pragma once
+
+#include <voyx/Header.h>
+#include <voyx/etc/Heap.h>
+#include <voyx/etc/Realtime.h>
+
+/**
+ * Persistent worker threads for fork-join style parallel loops.
+ * The calling thread participates in the work as well.
+ *
+ * Since the calling thread waits for the workers, the workers promote themselves
+ * to the same real-time priority, each on the next core after the calling one.
+ * Likewise, the workers inherit the Heap::Realtime scope of the calling thread.
+ **/
+class ThreadPool
+{
+
+public:
+
+  ThreadPool(const size_t threads = std::thread::hardware_concurrency())
+  {
+    const size_t workers = std::max(threads, size_t(1)) - 1;
+
+    for (size_t i = 0; i < workers; ++i)
+    {
+      this->workers.emplace_back([this, i]() { loop(i); });
+    }
+  }
+
+  ~ThreadPool()
+  {
+    {
+      std::lock_guard lock(mutex);
+      doloop = false;
+    }
+
+    condition.notify_all();
+
+    for (auto& worker : workers)
+    {
+      if (worker.joinable())
+      {
+        worker.join();
+      }
+    }
+  }
+
+  size_t size() const
+  {
+    return workers.size() + 1;
+  }
+
+  /**
+   * Invokes the specified task for each index from 0 to count-1
+   * and returns as soon as all invocations have been completed.
+   **/
+  void operator()(const size_t count, voyx::function_ref<void(const size_t index)> task)
+  {
+    if (!count)
+    {
+      return;
+    }
+
+    if (workers.empty() || count == 1)
+    {
+      for (size_t index = 0; index < count; ++index)
+      {
+        task(index);
+      }
+
+      return;
+    }
+
+    std::lock_guard calls(serial);
+
+    {
+      std::lock_guard lock(mutex);
+
+      job.task = &task;
+      job.count = count;
+      job.next = 0;
+      job.done = 0;
+      job.error = nullptr;
+      job.realtime = Heap::realtime();
+      job.generation++;
+    }
+
+    condition.notify_all();
+
+    work();
+
+    std::unique_lock lock(mutex);
+
+    finished.wait(lock, [this]()
+    {
+      return job.done == job.count && !job.active;
+    });
+
+    job.task = nullptr;
+
+    if (job.error)
+    {
+      std::rethrow_exception(job.error);
+    }
+  }
+
+  /**
+   * Splits the index range from 0 to count-1 into at most one contiguous chunk per thread
+   * and invokes the specified task for each chunk, which keeps the synchronization overhead low
+   * for many short tasks like the per-hop transforms of a single frame.
+   **/
+  void chunks(const size_t count, voyx::function_ref<void(const size_t first, const size_t last)> task)
+  {
+    const size_t chunks = std::min(count, size());
+
+    (*this)(chunks, [&](const size_t chunk)
+    {
+      task(chunk * count / chunks, (chunk + 1) * count / chunks);
+    });
+  }
+
+private:
+
+  struct
+  {
+    const voyx::function_ref<void(const size_t index)>* task = nullptr;
+    size_t count = 0;
+    std::atomic<size_t> next = 0;
+    std::atomic<size_t> done = 0;
+    size_t active = 0;
+    size_t generation = 0;
+    std::exception_ptr error;
+    bool realtime = false;
+  }
+  job;
+
+  std::vector<std::thread> workers;
+  bool doloop = true;
+
+  std::mutex serial;
+  std::mutex mutex;
+  std::condition_variable condition;
+  std::condition_variable finished;
+
+  void loop(const size_t worker)
+  {
+    size_t generation = 0;
+    bool promoted = false;
+
+    std::unique_lock lock(mutex);
+
+    while (true)
+    {
+      condition.wait(lock, [&]()
+      {
+        return !doloop || generation != job.generation;
+      });
+
+      if (!doloop)
+      {
+        break;
+      }
+
+      generation = job.generation;
+
+      job.active++;
+      const bool realtime = job.realtime;
+      lock.unlock();
+
+      // promote lazily, since the real-time mode
+      // is typically configured after the pool has been created
+      if (!promoted)
+      {
+        Realtime::promote("thread pool worker " + std::to_string(worker), worker + 1);
+        promoted = true;
+      }
+
+      if (realtime)
+      {
+        Heap::Realtime scope;
+        work();
+      }
+      else
+      {
+        work();
+      }
+
+      lock.lock();
+      job.active--;
+
+      finished.notify_all();
+    }
+  }
+
+  void work()
+  {
+    while (true)
+    {
+      const size_t index = job.next.fetch_add(1);
+
+      if (index >= job.count)
+      {
+        break;
+      }
+
+      try
+      {
+        (*job.task)(index);
+      }
+      catch (...)
+      {
+        std::lock_guard lock(mutex);
+
+        if (!job.error)
+        {
+          job.error = std::current_exception();
+        }
+      }
+
+      if (job.done.fetch_add(1) + 1 == job.count)
+      {
+        std::lock_guard lock(mutex);
+
+        finished.notify_all();
+      }
+    }
+  }
+
+};
@@ -8,28 +8,58 @@ template<> struct WellKnownTimerDuration<std::chrono::milliseconds> : std::true_
 template<> struct WellKnownTimerDuration<std::chrono::microseconds> : std::true_type {};
 template<> struct WellKnownTimerDuration<std::chrono::nanoseconds> : std::true_type {};
 
+/**
+ * Fixed memory duration statistics based on an HDR style histogram.
+ *
+ * Values are recorded in nanoseconds into log-linear buckets with 64 sub-buckets
+ * per power of two, so that each percentile is accurate to within 1.6 percent
+ * up to about 18 minutes. Each recording is a few relaxed atomic increments,
+ * so that the statistics can be read by another thread without locking.
+ *
+ * Optionally, recordings exceeding the specified deadline
+ * (e.g. the frame period) are counted as misses.
+ **/
 template<typename T>
 class Timer
 {
 
 public:
 
-  Timer(const size_t capacity = 100000)
+  Timer()
   {
     static_assert(WellKnownTimerDuration<T>::value, "s,ms,us,ns");
 
-    data.reserve(capacity);
+    cls();
   }
 
   Timer(const Timer& other)
   {
-    data.reserve(other.data.capacity());
-    data.assign(other.data.begin(), other.data.end());
+    cls();
+    merge(other);
+
+    limit = other.limit;
+  }
+
+  /**
+   * Sets the deadline to count misses against, zero disables it.
+   **/
+  void deadline(const std::chrono::duration<double> duration)
+  {
+    limit = static_cast<uint64_t>(std::max(duration.count(), 0.0) * 1e+9);
   }
 
   void cls()
   {
-    data.clear();
+    for (auto& bucket : buckets)
+    {
+      bucket.store(0, std::memory_order_relaxed);
+    }
+
+    total.count.store(0, std::memory_order_relaxed);
+    total.misses.store(0, std::memory_order_relaxed);
+    total.sum.store(0, std::memory_order_relaxed);
+    total.sumsum.store(0, std::memory_order_relaxed);
+    total.max.store(0, std::memory_order_relaxed);
   }
 
   void tic()
@@ -39,13 +69,143 @@ public:
 
   void toc()
   {
-    const std::chrono::steady_clock::duration duration = std::chrono::steady_clock::now() - timestamp;
-    const double value = std::chrono::duration_cast<T>(duration * 1e+3).count() * 1e-3;
+    add(std::chrono::steady_clock::now() - timestamp);
+  }
+
+  /**
+   * Records an externally measured duration.
+   **/
+  void add(const std::chrono::duration<double> duration)
+  {
+    const uint64_t value = static_cast<uint64_t>(std::clamp(duration.count() * 1e+9, 0.0, double(maxvalue)));
+    const double seconds = value * 1e-9;
+
+    buckets[bucket(value)].fetch_add(1, std::memory_order_relaxed);
+
+    total.count.fetch_add(1, std::memory_order_relaxed);
+    total.misses.fetch_add((limit && value > limit) ? 1 : 0, std::memory_order_relaxed);
+    total.sum.fetch_add(seconds, std::memory_order_relaxed);
+    total.sumsum.fetch_add(seconds * seconds, std::memory_order_relaxed);
+
+    uint64_t max = total.max.load(std::memory_order_relaxed);
+    while (max < value && !total.max.compare_exchange_weak(max, value, std::memory_order_relaxed)) {}
+  }
+
+  /**
+   * Accumulates the recordings of another timer, e.g. of a shorter period.
+   **/
+  void merge(const Timer& other)
+  {
+    for (size_t i = 0; i < buckets.size(); ++i)
+    {
+      buckets[i].fetch_add(other.buckets[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+
+    total.count.fetch_add(other.total.count.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    total.misses.fetch_add(other.total.misses.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    total.sum.fetch_add(other.total.sum.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    total.sumsum.fetch_add(other.total.sumsum.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+    const uint64_t value = other.total.max.load(std::memory_order_relaxed);
+    uint64_t max = total.max.load(std::memory_order_relaxed);
+    while (max < value && !total.max.compare_exchange_weak(max, value, std::memory_order_relaxed)) {}
+  }
+
+  /**
+   * Moves the recordings into the other timer, e.g. the accumulated statistics,
+   * while recordings may be added concurrently. Each counter is exchanged with zero,
+   * so that a concurrent recording is either moved or remains for the next time.
+   * Also passes on the deadline, unless the other timer has one.
+   **/
+  void drain(Timer& other)
+  {
+    for (size_t i = 0; i < buckets.size(); ++i)
+    {
+      other.buckets[i].fetch_add(buckets[i].exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+
+    other.total.count.fetch_add(total.count.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+    other.total.misses.fetch_add(total.misses.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+    other.total.sum.fetch_add(total.sum.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+    other.total.sumsum.fetch_add(total.sumsum.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+
+    const uint64_t value = total.max.exchange(0, std::memory_order_relaxed);
+    uint64_t max = other.total.max.load(std::memory_order_relaxed);
+    while (max < value && !other.total.max.compare_exchange_weak(max, value, std::memory_order_relaxed)) {}
+
+    if (!other.limit)
+    {
+      other.limit = limit;
+    }
+  }
+
+  size_t count() const
+  {
+    return total.count.load(std::memory_order_relaxed);
+  }
+
+  size_t misses() const
+  {
+    return total.misses.load(std::memory_order_relaxed);
+  }
+
+  double mean() const
+  {
+    const size_t n = count();
+
+    return n ? convert(total.sum.load(std::memory_order_relaxed) / n) : 0;
+  }
+
+  double stdev() const
+  {
+    const size_t n = count();
+
+    if (!n)
+    {
+      return 0;
+    }
+
+    const double mean = total.sum.load(std::memory_order_relaxed) / n;
+    const double meansum = total.sumsum.load(std::memory_order_relaxed) / n;
+
+    return convert(std::sqrt(std::max(meansum - mean * mean, 0.0)));
+  }
+
+  double max() const
+  {
+    return convert(total.max.load(std::memory_order_relaxed) * 1e-9);
+  }
+
+  /**
+   * Returns the specified percentile between 0 and 100.
+   **/
+  double percentile(const double percent) const
+  {
+    const size_t n = count();
 
-    data.push_back(value);
+    if (!n)
+    {
+      return 0;
+    }
+
+    const size_t rank = std::max<size_t>(1, static_cast<size_t>(std::ceil(n * std::clamp(percent, 0.0, 100.0) / 100)));
+
+    size_t sum = 0;
+
+    for (size_t i = 0; i < buckets.size(); ++i)
+    {
+      sum += buckets[i].load(std::memory_order_relaxed);
+
+      if (sum >= rank)
+      {
+        return std::min(convert(value(i) * 1e-9), max());
+      }
+    }
+
+    return max();
   }
 
-  std::string str()
+  static std::string unit()
   {
     const std::map<intmax_t, std::string> units =
     {
@@ -55,24 +215,126 @@ public:
       { 1, "s" }
     };
 
-    const std::string unit = units.at(T::period::num * T::period::den);
+    return units.at(T::period::num * T::period::den);
+  }
+
+  std::string str() const
+  {
+    std::ostringstream result;
+    result.precision(3);
 
-    const double sum = std::accumulate(data.begin(), data.end(), 0.0);
-    const double sumsum = std::inner_product(data.begin(), data.end(), data.begin(), 0.0);
+    result << mean() << " ± " << stdev() << " " << unit() << " n=" << count()
+           << " p50=" << percentile(50)
+           << " p99=" << percentile(99)
+           << " max=" << max();
 
-    const double mean = sum / data.size();
-    const double stdev = std::sqrt(sumsum / data.size() - mean * mean);
+    if (limit)
+    {
+      result << " miss=" << misses();
+    }
 
+    return result.str();
+  }
+
+  /**
+   * Returns the column names of the csv() row.
+   **/
+  static std::string csvheader()
+  {
+    return "name,unit,count,mean,stdev,p50,p90,p99,p99.9,max,misses";
+  }
+
+  std::string csv(const std::string& name) const
+  {
     std::ostringstream result;
-    result.precision(3);
-    result << mean << " ± " << stdev << " " << unit << " n=" << data.size();
+
+    result << name << "," << unit() << "," << count() << ","
+           << mean() << "," << stdev() << ","
+           << percentile(50) << "," << percentile(90) << ","
+           << percentile(99) << "," << percentile(99.9) << ","
+           << max() << "," << misses();
+
+    return result.str();
+  }
+
+  std::string json(const std::string& name) const
+  {
+    std::ostringstream result;
+
+    result << "{ \"name\": \"" << name << "\", \"unit\": \"" << unit() << "\", "
+           << "\"count\": " << count() << ", "
+           << "\"mean\": " << mean() << ", "
+           << "\"stdev\": " << stdev() << ", "
+           << "\"p50\": " << percentile(50) << ", "
+           << "\"p90\": " << percentile(90) << ", "
+           << "\"p99\": " << percentile(99) << ", "
+           << "\"p99.9\": " << percentile(99.9) << ", "
+           << "\"max\": " << max() << ", "
+           << "\"misses\": " << misses() << " }";
 
     return result.str();
   }
 
 private:
 
+  static const size_t subbits = 6;
+  static const size_t subcount = size_t(1) << subbits;
+  static const size_t maxbits = 40;
+  static const uint64_t maxvalue = (uint64_t(1) << maxbits) - 1;
+
   std::chrono::time_point<std::chrono::steady_clock> timestamp;
-  std::vector<double> data;
+  uint64_t limit = 0;
+
+  std::array<std::atomic<size_t>, subcount * 2 + (maxbits - subbits - 1) * subcount> buckets;
+
+  struct
+  {
+    std::atomic<size_t> count;
+    std::atomic<size_t> misses;
+    std::atomic<double> sum;
+    std::atomic<double> sumsum;
+    std::atomic<uint64_t> max;
+  }
+  total;
+
+  /**
+   * Values below 2*subcount have their own bucket, while above
+   * each power of two is split into subcount equal buckets.
+   **/
+  static size_t bucket(const uint64_t value)
+  {
+    if (value < subcount * 2)
+    {
+      return static_cast<size_t>(value);
+    }
+
+    const size_t msb = std::bit_width(value) - 1;
+    const size_t shift = msb - subbits;
+    const size_t sub = static_cast<size_t>(value >> shift) - subcount;
+
+    return subcount * 2 + (shift - 1) * subcount + sub;
+  }
+
+  /**
+   * Returns the midpoint of the specified bucket.
+   **/
+  static uint64_t value(const size_t bucket)
+  {
+    if (bucket < subcount * 2)
+    {
+      return bucket;
+    }
+
+    const size_t shift = (bucket - subcount * 2) / subcount + 1;
+    const uint64_t sub = (bucket - subcount * 2) % subcount + subcount;
+
+    return (sub << shift) + (uint64_t(1) << shift) / 2;
+  }
+
+  static double convert(const double seconds)
+  {
+    return std::chrono::duration_cast<std::chrono::duration<double, typename T::period>>(
+      std::chrono::duration<double>(seconds)).count();
+  }
 
 };
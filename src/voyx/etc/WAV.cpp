@@ -5,17 +5,36 @@
 
 #include <dr_wav.h>
 
-void WAV::read(const std::string& path, std::vector<double>& data, const double samplerate)
+size_t WAV::channels(const std::string& path)
+{
+  drwav wav;
+
+  if (drwav_init_file(&wav, path.c_str(), nullptr) != DRWAV_TRUE)
+  {
+    throw std::runtime_error(
+      $("Unable to open \"{0}\"!", path));
+  }
+
+  const size_t channels = wav.channels;
+
+  drwav_uninit(&wav);
+
+  return channels;
+}
+
+void WAV::read(const std::string& path, std::vector<double>& data, const double samplerate, const size_t channels)
 {
   std::vector<float> nativedata;
 
-  WAV::read(path, nativedata, samplerate);
+  WAV::read(path, nativedata, samplerate, channels);
 
   data.assign(nativedata.begin(), nativedata.end());
 }
 
-void WAV::read(const std::string& path, std::vector<float>& data, const double samplerate)
+void WAV::read(const std::string& path, std::vector<float>& data, const double samplerate, const size_t channels)
 {
+  voyxassert(channels > 0);
+
   drwav wav;
 
   if (drwav_init_file(&wav, path.c_str(), nullptr) != DRWAV_TRUE)
@@ -25,8 +44,8 @@ void WAV::read(const std::string& path, std::vector<float>& data, const double s
   }
 
   const size_t samples = wav.totalPCMFrameCount;
-  const size_t channels = wav.channels;
-  const size_t bytes = samples * channels * sizeof(float);
+  const size_t filechannels = wav.channels;
+  const size_t bytes = samples * filechannels * sizeof(float);
 
   if (bytes > DRWAV_SIZE_MAX)
   {
@@ -36,7 +55,7 @@ void WAV::read(const std::string& path, std::vector<float>& data, const double s
       $("The file is too large \"{0}\"!", path));
   }
 
-  data.resize(samples * channels);
+  data.resize(samples * filechannels);
 
   if (drwav_read_pcm_frames_f32(&wav, samples, data.data()) != samples)
   {
@@ -48,46 +67,62 @@ void WAV::read(const std::string& path, std::vector<float>& data, const double s
 
   drwav_uninit(&wav);
 
-  if (channels > 1)
+  if (channels == 1 && filechannels > 1)
   {
     for (size_t i = 0; i < samples; ++i)
     {
-      data[i] = data[i * channels];
+      data[i] = data[i * filechannels];
 
-      for (size_t j = 1; j < channels; ++j)
+      for (size_t j = 1; j < filechannels; ++j)
       {
-        data[i] += data[i * channels + j];
+        data[i] += data[i * filechannels + j];
       }
 
-      data[i] /= channels;
+      data[i] /= filechannels;
     }
 
     data.resize(samples);
   }
+  else if (channels != filechannels)
+  {
+    std::vector<float> buffer(samples * channels);
+
+    for (size_t i = 0; i < samples; ++i)
+    {
+      for (size_t j = 0; j < channels; ++j)
+      {
+        buffer[i * channels + j] = data[i * filechannels + j % filechannels];
+      }
+    }
+
+    data.swap(buffer);
+  }
 
   if (wav.sampleRate != samplerate)
   {
     SRC<float> convert({ wav.sampleRate, samplerate });
 
-    std::vector<float> buffer(data.size() * convert.quotient());
+    std::vector<float> buffer(static_cast<size_t>(samples * convert.quotient()) * channels);
 
-    convert(data, buffer);
+    convert(data, buffer, channels);
 
     data.assign(buffer.begin(), buffer.end());
   }
 }
 
-void WAV::write(const std::string& path, const std::vector<double>& data, const double samplerate)
+void WAV::write(const std::string& path, const std::vector<double>& data, const double samplerate, const size_t channels)
 {
   std::vector<float> nativedata(data.begin(), data.end());
 
-  WAV::write(path, nativedata, samplerate);
+  WAV::write(path, nativedata, samplerate, channels);
 }
 
-void WAV::write(const std::string& path, const std::vector<float>& data, const double samplerate)
+void WAV::write(const std::string& path, const std::vector<float>& data, const double samplerate, const size_t channels)
 {
-  const size_t samples = data.size();
-  const size_t channels = 1;
+  voyxassert(channels > 0);
+  voyxassert(data.size() % channels == 0);
+
+  const size_t samples = data.size() / channels;
   const size_t bytes = samples * channels * sizeof(float);
 
   if (bytes > DRWAV_SIZE_MAX)
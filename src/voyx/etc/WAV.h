@@ -2,11 +2,20 @@
 
 #include <voyx/Header.h>
 
+/**
+ * Reads and writes interleaved samples of the specified number of channels.
+ *
+ * If the file contains a different number of channels, all file channels
+ * are averaged into a single one, or the file channels are repeated
+ * respectively truncated to match the requested number of channels.
+ **/
 struct WAV
 {
-  static void read(const std::string& path, std::vector<double>& data, const double samplerate);
-  static void read(const std::string& path, std::vector<float>& data, const double samplerate);
+  static size_t channels(const std::string& path);
 
-  static void write(const std::string& path, const std::vector<double>& data, const double samplerate);
-  static void write(const std::string& path, const std::vector<float>& data, const double samplerate);
+  static void read(const std::string& path, std::vector<double>& data, const double samplerate, const size_t channels = 1);
+  static void read(const std::string& path, std::vector<float>& data, const double samplerate, const size_t channels = 1);
+
+  static void write(const std::string& path, const std::vector<double>& data, const double samplerate, const size_t channels = 1);
+  static void write(const std::string& path, const std::vector<float>& data, const double samplerate, const size_t channels = 1);
 };
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <voyx/Header.h>
+#include <voyx/etc/ThreadPool.h>
+
+/**
+ * Spectral effect node of the GraphPipeline.
+ *
+ * All nodes operate on the same vocoder encoded dfts, i.e. the real part
+ * contains the magnitude and the imaginary part the instantaneous frequency
+ * of each bin in hertz, so that neither the STFT nor the vocoder
+ * needs to be computed more than once per frame.
+ **/
+class Effect
+{
+
+public:
+
+  virtual ~Effect() {}
+
+  /**
+   * Preallocates the workspaces for the specified number of hops per frame.
+   **/
+  virtual void reserve(const size_t hops) {}
+
+  /**
+   * Enables the intra-frame parallel mode, which distributes the hops of each frame
+   * across the specified thread pool, analogous to the StftPipeline.
+   **/
+  virtual void parallelize(std::shared_ptr<ThreadPool> pool)
+  {
+    this->pool = pool;
+  }
+
+  virtual void operator()(const size_t index, voyx::matrix<phasor_t> dfts) = 0;
+
+protected:
+
+  /**
+   * Invokes the callback for each hop, concurrently in the intra-frame parallel mode.
+   * So the callback must not modify any state which is shared between the hops.
+   **/
+  void foreach(voyx::matrix<phasor_t> dfts, voyx::function_ref<void(const size_t hop, voyx::vector<phasor_t> dft)> callback)
+  {
+    if (pool == nullptr || dfts.size() < 2)
+    {
+      for (size_t hop = 0; hop < dfts.size(); ++hop)
+      {
+        callback(hop, dfts[hop]);
+      }
+
+      return;
+    }
+
+    pool->chunks(dfts.size(), [&](const size_t first, const size_t last)
+    {
+      for (size_t hop = first; hop < last; ++hop)
+      {
+        callback(hop, dfts[hop]);
+      }
+    });
+  }
+
+private:
+
+  std::shared_ptr<ThreadPool> pool;
+
+};
@@ -0,0 +1,61 @@
+#include <voyx/fx/FormantEffect.h>
+
+#include <voyx/Source.h>
+
+FormantEffect::FormantEffect(const double samplerate, const size_t dftsize, const double quefrency,
+                             const std::vector<std::shared_ptr<Effect>>& effects,
+                             std::shared_ptr<ChannelLink> link, const size_t channel) :
+  lifter(quefrency, samplerate, dftsize * 2 - 2),
+  effects(effects),
+  link(link),
+  channel(channel)
+{
+  data.envelope.resize(dftsize);
+}
+
+void FormantEffect::reserve(const size_t hops)
+{
+  for (auto& effect : effects)
+  {
+    effect->reserve(hops);
+  }
+}
+
+void FormantEffect::parallelize(std::shared_ptr<ThreadPool> pool)
+{
+  Effect::parallelize(pool);
+
+  for (auto& effect : effects)
+  {
+    effect->parallelize(pool);
+  }
+}
+
+void FormantEffect::operator()(const size_t index, voyx::matrix<phasor_t> dfts)
+{
+  // the linked channels reuse the envelope of the leading channel
+  voyx::vector<phasor_t::value_type> envelope = link ? link->envelope() : voyx::vector<phasor_t::value_type>(data.envelope);
+
+  if (link == nullptr || ChannelLink::leader(channel))
+  {
+    VOYXZONE("formant.lowpass");
+    lifter.lowpass<$$::real>(dfts.front(), envelope);
+  }
+
+  foreach(dfts, [&](const size_t hop, voyx::vector<phasor_t> dft)
+  {
+    VOYXZONE("formant.divide");
+    lifter.divide<$$::real>(dft, envelope);
+  });
+
+  for (auto& effect : effects)
+  {
+    (*effect)(index, dfts);
+  }
+
+  foreach(dfts, [&](const size_t hop, voyx::vector<phasor_t> dft)
+  {
+    VOYXZONE("formant.multiply");
+    lifter.multiply<$$::real>(dft, envelope);
+  });
+}
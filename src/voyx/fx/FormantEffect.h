@@ -0,0 +1,45 @@
+#pragma once
+
+#include <voyx/Header.h>
+#include <voyx/alg/Lifter.h>
+#include <voyx/dsp/ChannelLink.h>
+#include <voyx/etc/Profiler.h>
+#include <voyx/fx/Effect.h>
+
+/**
+ * Preserves the formants of the wrapped effects by removing the spectral envelope
+ * before and restoring it afterwards, so that e.g. a pitch shift
+ * doesn't change the timbre of the voice.
+ *
+ * If linked, only the leading channel estimates the envelope.
+ **/
+class FormantEffect : public Effect
+{
+
+public:
+
+  FormantEffect(const double samplerate, const size_t dftsize, const double quefrency,
+                const std::vector<std::shared_ptr<Effect>>& effects,
+                std::shared_ptr<ChannelLink> link = nullptr, const size_t channel = 0);
+
+  void reserve(const size_t hops) override;
+  void parallelize(std::shared_ptr<ThreadPool> pool) override;
+
+  void operator()(const size_t index, voyx::matrix<phasor_t> dfts) override;
+
+private:
+
+  Lifter<phasor_t::value_type> lifter;
+
+  const std::vector<std::shared_ptr<Effect>> effects;
+
+  const std::shared_ptr<ChannelLink> link;
+  const size_t channel;
+
+  struct
+  {
+    std::vector<phasor_t::value_type> envelope;
+  }
+  data;
+
+};
@@ -0,0 +1,42 @@
+#include <voyx/fx/HarmonicEffect.h>
+
+#include <voyx/Source.h>
+
+HarmonicEffect::HarmonicEffect(const double frequency, std::shared_ptr<MidiObserver> midi) :
+  frequency(frequency),
+  midi(midi)
+{
+  voyxassert(frequency > 0);
+}
+
+void HarmonicEffect::operator()(const size_t index, voyx::matrix<phasor_t> dfts)
+{
+  double fundamental = frequency;
+
+  if (midi != nullptr)
+  {
+    midi->snapshot(midistate);
+
+    if (!midistate.notes().empty())
+    {
+      fundamental = midistate.notes().front();
+    }
+  }
+
+  foreach(dfts, [&](const size_t hop, voyx::vector<phasor_t> dft)
+  {
+    VOYXZONE("harmonic");
+
+    for (size_t i = 0; i < dft.size(); ++i)
+    {
+      const auto harmonic = std::round(dft[i].imag() / fundamental);
+
+      dft[i].imag(static_cast<phasor_t::value_type>(harmonic * fundamental));
+
+      if (harmonic < 1)
+      {
+        dft[i].real(0);
+      }
+    }
+  });
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <voyx/Header.h>
+#include <voyx/etc/Profiler.h>
+#include <voyx/fx/Effect.h>
+#include <voyx/io/MidiObserver.h>
+
+/**
+ * Moves each bin to the nearest harmonic of the lowest pressed MIDI key,
+ * or of the specified fallback frequency if there is no key pressed or no MIDI input at all.
+ *
+ * In contrast to the RobotPipeline, which resynthesizes the magnitudes with
+ * a bank of oscillators per pressed and sustained key on top of the sliding DFT,
+ * this effect is monophonic and keeps the vocoder encoded bins,
+ * since a single instantaneous frequency per bin cannot represent several keys.
+ **/
+class HarmonicEffect : public Effect
+{
+
+public:
+
+  HarmonicEffect(const double frequency, std::shared_ptr<MidiObserver> midi);
+
+  void operator()(const size_t index, voyx::matrix<phasor_t> dfts) override;
+
+private:
+
+  const double frequency;
+
+  std::shared_ptr<MidiObserver> midi;
+  MidiObserver::Snapshot midistate;
+
+};
@@ -0,0 +1,72 @@
+#include <voyx/fx/PitchShiftEffect.h>
+
+#include <voyx/Source.h>
+
+PitchShiftEffect::PitchShiftEffect(const double samplerate, const size_t dftsize, const std::vector<double>& factors) :
+  samplerate(samplerate),
+  dftsize(dftsize),
+  factors(factors)
+{
+  voyxassert(!factors.empty());
+
+  reserve(1);
+}
+
+void PitchShiftEffect::reserve(const size_t hops)
+{
+  // separate workspaces per hop for the intra-frame parallel mode
+  data.buffer.resize(hops * factors.size() * dftsize);
+  data.mask.resize(hops * dftsize);
+}
+
+void PitchShiftEffect::operator()(const size_t index, voyx::matrix<phasor_t> dfts)
+{
+  voyxassert(data.mask.size() >= dfts.size() * dftsize);
+
+  const double roi[] = { 0, samplerate / 2 };
+
+  foreach(dfts, [&](const size_t hop, voyx::vector<phasor_t> dft)
+  {
+    voyx::matrix<phasor_t> buffers(
+      data.buffer.data() + hop * factors.size() * dftsize,
+      factors.size() * dftsize, dftsize);
+
+    voyx::vector<size_t> mask(
+      data.mask.data() + hop * dftsize,
+      dftsize);
+
+    {
+      VOYXZONE("pitchshift.interp");
+
+      for (size_t i = 0; i < factors.size(); ++i)
+      {
+        $$::interp(dft, buffers[i], factors[i]);
+      }
+    }
+
+    {
+      VOYXZONE("pitchshift.argmax");
+      $$::argmax<$$::real>(buffers, mask);
+    }
+
+    {
+      VOYXZONE("pitchshift.shift");
+
+      for (size_t i = 0; i < dft.size(); ++i)
+      {
+        const size_t j = mask[i];
+
+        dft[i] = buffers(j, i);
+
+        const auto frequency = dft[i].imag() * factors[j];
+
+        dft[i].imag(frequency);
+
+        if (frequency <= roi[0] || roi[1] <= frequency)
+        {
+          dft[i].real(0);
+        }
+      }
+    }
+  });
+}
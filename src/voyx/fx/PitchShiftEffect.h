@@ -0,0 +1,35 @@
+#pragma once
+
+#include <voyx/Header.h>
+#include <voyx/etc/Profiler.h>
+#include <voyx/fx/Effect.h>
+
+/**
+ * Shifts the pitch by one or more factors at once,
+ * keeping the strongest shifted component of each bin.
+ **/
+class PitchShiftEffect : public Effect
+{
+
+public:
+
+  PitchShiftEffect(const double samplerate, const size_t dftsize, const std::vector<double>& factors);
+
+  void reserve(const size_t hops) override;
+
+  void operator()(const size_t index, voyx::matrix<phasor_t> dfts) override;
+
+private:
+
+  const double samplerate;
+  const size_t dftsize;
+  const std::vector<double> factors;
+
+  struct
+  {
+    std::vector<phasor_t> buffer;
+    std::vector<size_t> mask;
+  }
+  data;
+
+};
@@ -2,23 +2,14 @@
 
 #include <voyx/Source.h>
 
-AudioSink::AudioSink(const std::string& name, double samplerate, size_t framesize, size_t buffersize) :
-  Sink(samplerate, framesize, buffersize),
+AudioSink::AudioSink(const std::string& name, double samplerate, size_t framesize, size_t buffersize, size_t blocksize, size_t channels) :
+  Sink(samplerate, framesize, buffersize, channels),
   audio_device_name(name),
-  audio_sync_semaphore(buffersize),
-  audio_frame_buffer(
-    buffersize,
-    [framesize](size_t index)
-    {
-      auto output = new OutputFrame();
-      output->index = index;
-      output->frame.resize(framesize);
-      return output;
-    },
-    [](OutputFrame* output)
-    {
-      delete output;
-    })
+  audio_block_size(blocksize ? blocksize : framesize),
+  audio_sync_semaphore(0),
+  audio_sync_limit(0),
+  audio_stream_latency(0),
+  audio_events("Audio sink")
 {
 }
 
@@ -59,7 +50,7 @@ void AudioSink::open()
         continue;
       }
 
-      if (device.outputChannels < 1)
+      if (device.outputChannels < channels())
       {
         continue;
       }
@@ -85,12 +76,12 @@ void AudioSink::open()
 
   RtAudio::StreamParameters stream_parameters;
   stream_parameters.deviceId = id.value();
-  stream_parameters.nChannels = 1;
+  stream_parameters.nChannels = static_cast<uint32_t>(channels());
   stream_parameters.firstChannel = 0;
 
   const RtAudioFormat stream_format = (typeid(sample_t) == typeid(float)) ? RTAUDIO_FLOAT32 : RTAUDIO_FLOAT64;
   uint32_t stream_samplerate = device.preferredSampleRate;
-  uint32_t stream_framesize = static_cast<uint32_t>(framesize());
+  uint32_t stream_framesize = static_cast<uint32_t>(audio_block_size);
 
   for (const uint32_t native_samplerate : device.sampleRates)
   {
@@ -105,7 +96,7 @@ void AudioSink::open()
 
   stream_framesize *= audio_samplerate_converter.quotient();
 
-  if (stream_samplerate != samplerate())
+  if (stream_samplerate != samplerate() || stream_framesize != framesize())
   {
     LOG(INFO) << $("Opening audio sink stream with sr={0} and fs={1}.",
                    stream_samplerate, stream_framesize);
@@ -122,12 +113,28 @@ void AudioSink::open()
     nullptr,
     &AudioSink::error);
 
-  if (stream_framesize != framesize() * audio_samplerate_converter.quotient())
-  {
-    throw std::runtime_error(
-      $("Unexpected audio sink stream frame size {0} != {1} * {2}!",
-        stream_framesize, framesize(), audio_samplerate_converter.quotient()));
-  }
+  // the device may have chosen a different block size,
+  // which is fine as long as the ring can hold it
+
+  const size_t blocksize = static_cast<size_t>(stream_framesize / audio_samplerate_converter.quotient());
+  const size_t blocks = (blocksize + framesize() - 1) / framesize();
+
+  audio_block_buffer.resize(blocksize * channels());
+  audio_channel_buffer.resize(framesize() * channels());
+  audio_frame_buffer = std::make_unique<Ring<sample_t>>(std::max(buffersize(), blocks) * framesize() * channels());
+
+  // keep no more than one device block plus one frame queued,
+  // otherwise a non-device source would fill the whole ring
+  // and delay the output by the full buffer size
+
+  audio_sync_limit = std::min(std::max(buffersize(), blocks), blocks + 1) * framesize() * channels();
+
+  // the reported stream latency may be zero if not supported
+  // by the host api, so count at least one device block
+
+  const size_t latency = static_cast<size_t>(audio.getStreamLatency() / audio_samplerate_converter.quotient());
+
+  audio_stream_latency = std::max(latency, blocksize);
 }
 
 void AudioSink::close()
@@ -143,6 +150,11 @@ void AudioSink::close()
   }
 }
 
+size_t AudioSink::latency() const
+{
+  return audio_frame_buffer ? audio_frame_buffer->size() / channels() + audio_stream_latency : 0;
+}
+
 void AudioSink::start()
 {
   if (!audio.isStreamOpen())
@@ -175,22 +187,75 @@ void AudioSink::stop()
 
 bool AudioSink::write(const size_t index, const voyx::vector<sample_t> frame)
 {
-  const bool ok = audio_frame_buffer.write([&](OutputFrame& output)
+  voyxassert(audio_frame_buffer != nullptr);
+
+  bool ok = false;
+
+  if (channels() == 1)
   {
-    output.frame.assign(frame.begin(), frame.end());
-  });
+    ok = audio_frame_buffer->write(frame.data(), frame.size());
+  }
+  else
+  {
+    ok = audio_frame_buffer->write(frame.size(), [&](voyx::vector<sample_t> samples)
+    {
+      $$::interleave(voyx::matrix<sample_t>(frame, framesize()), samples.data());
+    });
+  }
 
   if (!ok)
   {
     LOG(WARNING) << $("Audio sink fifo overflow!");
+    return false;
+  }
+
+  return true;
+}
+
+bool AudioSink::write(const size_t index, voyx::function_ref<void(voyx::vector<sample_t> frame)> callback)
+{
+  voyxassert(audio_frame_buffer != nullptr);
+
+  const bool ok = audio_frame_buffer->write(framesize() * channels(), [&](voyx::vector<sample_t> frame)
+  {
+    if (channels() == 1)
+    {
+      callback(frame);
+      return;
+    }
+
+    voyx::matrix<sample_t> planes(audio_channel_buffer, framesize());
+
+    callback(audio_channel_buffer);
+
+    $$::interleave(planes, frame.data());
+  });
+
+  if (!ok)
+  {
+    // render anyway to keep the pipeline state consistent
+    return Sink::write(index, callback);
   }
 
-  return ok;
+  return true;
 }
 
 bool AudioSink::sync()
 {
-  return audio_sync_semaphore.try_acquire_for(timeout());
+  voyxassert(audio_frame_buffer != nullptr);
+
+  while (audio_frame_buffer->size() + framesize() * channels() > audio_sync_limit)
+  {
+    if (!audio_sync_semaphore.try_acquire_for(timeout()))
+    {
+      return false;
+    }
+  }
+
+  // discard obsolete notifications
+  while (audio_sync_semaphore.try_acquire()) {}
+
+  return true;
 }
 
 int AudioSink::callback(void* output_frame_data, void* input_frame_data, uint32_t framesize, double timestamp, RtAudioStreamStatus status, void* $this)
@@ -198,33 +263,41 @@ int AudioSink::callback(void* output_frame_data, void* input_frame_data, uint32_
   auto& audio_frame_buffer = static_cast<AudioSink*>($this)->audio_frame_buffer;
   auto& audio_samplerate_converter = static_cast<AudioSink*>($this)->audio_samplerate_converter;
   auto& audio_sync_semaphore = static_cast<AudioSink*>($this)->audio_sync_semaphore;
+  auto& audio_events = static_cast<AudioSink*>($this)->audio_events;
+  auto& audio_block_buffer = static_cast<AudioSink*>($this)->audio_block_buffer;
 
-  const auto ok = audio_frame_buffer.read([&](OutputFrame& output)
-  {
-    if (framesize != output.frame.size() * audio_samplerate_converter.quotient())
-    {
-      LOG(WARNING) << $("Unexpected output frame size {0} != {1} * {2}!",
-                        framesize, output.frame.size(), audio_samplerate_converter.quotient());
-    }
+  const size_t channels = static_cast<AudioSink*>($this)->channels();
+  const size_t blocksize = static_cast<size_t>(framesize / audio_samplerate_converter.quotient()) * channels;
 
-    voyx::vector<sample_t> src = { output.frame.data(), output.frame.size() };
-    voyx::vector<sample_t> dst = { static_cast<sample_t*>(output_frame_data), framesize };
+  voyx::vector<sample_t> dst = { static_cast<sample_t*>(output_frame_data), framesize * channels };
 
-    audio_samplerate_converter(src, dst);
-  });
+  if (blocksize > audio_block_buffer.size())
+  {
+    audio_events.push(EventLog::Code::FrameSize,
+                      blocksize, audio_block_buffer.size());
 
-  if (!ok)
+    std::fill(dst.begin(), dst.end(), sample_t(0));
+  }
+  else if (audio_frame_buffer->read(audio_block_buffer.data(), blocksize))
   {
-    LOG(WARNING) << $("Audio sink fifo underflow!");
+    voyx::vector<sample_t> src = { audio_block_buffer.data(), blocksize };
+
+    audio_samplerate_converter(src, dst, channels);
+  }
+  else
+  {
+    audio_events.push(EventLog::Code::FifoUnderflow);
+
+    std::fill(dst.begin(), dst.end(), sample_t(0));
   }
 
   if (status == RTAUDIO_OUTPUT_UNDERFLOW)
   {
-    LOG(WARNING) << $("Audio sink stream underflow!");
+    audio_events.push(EventLog::Code::StreamUnderflow);
   }
   else if (status)
   {
-    LOG(WARNING) << $("Audio sink stream status {0}!", status);
+    audio_events.push(EventLog::Code::StreamStatus, status);
   }
 
   audio_sync_semaphore.release();
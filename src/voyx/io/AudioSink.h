@@ -2,7 +2,8 @@
 
 #include <voyx/Header.h>
 #include <voyx/alg/SRC.h>
-#include <voyx/etc/FIFO.h>
+#include <voyx/etc/EventLog.h>
+#include <voyx/etc/Ring.h>
 #include <voyx/io/Sink.h>
 
 #include <RtAudio.h>
@@ -12,7 +13,15 @@ class AudioSink : public Sink<sample_t>
 
 public:
 
-  AudioSink(const std::string& name, double samplerate, size_t framesize, size_t buffersize);
+  /**
+   * The optional blocksize specifies the device period independently
+   * of the framesize, e.g. a small one for low latency, zero means framesize.
+   * The device stream is interleaved, while the frames hold one channel after another.
+   *
+   * Regardless of the buffersize, sync blocks as long as more than one device block
+   * plus one frame is pending, so that the output latency stays low for any source.
+   **/
+  AudioSink(const std::string& name, double samplerate, size_t framesize, size_t buffersize, size_t blocksize = 0, size_t channels = 1);
 
   void open() override;
   void close() override;
@@ -20,22 +29,25 @@ public:
   void start() override;
   void stop() override;
 
+  size_t latency() const override;
+
   bool write(const size_t index, const voyx::vector<sample_t> frame) override;
+  bool write(const size_t index, voyx::function_ref<void(voyx::vector<sample_t> frame)> callback) override;
   bool sync() override;
 
 private:
 
-  struct OutputFrame
-  {
-    size_t index;
-    std::vector<sample_t> frame;
-  };
-
   const std::string audio_device_name;
+  const size_t audio_block_size;
   std::counting_semaphore<> audio_sync_semaphore;
-  FIFO<OutputFrame> audio_frame_buffer;
+  std::unique_ptr<Ring<sample_t>> audio_frame_buffer;
+  size_t audio_sync_limit;
+  std::vector<sample_t> audio_block_buffer;
+  std::vector<sample_t> audio_channel_buffer;
+  size_t audio_stream_latency;
   SRC<sample_t> audio_samplerate_converter;
 
+  EventLog audio_events;
   RtAudio audio;
 
   static int callback(void* output_frame_data, void* input_frame_data, uint32_t framesize, double timestamp, RtAudioStreamStatus status, void* $this);
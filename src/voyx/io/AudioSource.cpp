@@ -2,22 +2,13 @@
 
 #include <voyx/Source.h>
 
-AudioSource::AudioSource(const std::string& name, double samplerate, size_t framesize, size_t buffersize) :
-  Source(samplerate, framesize, buffersize),
+AudioSource::AudioSource(const std::string& name, double samplerate, size_t framesize, size_t buffersize, size_t blocksize, size_t channels) :
+  Source(samplerate, framesize, buffersize, channels),
   audio_device_name(name),
-  audio_frame_buffer(
-    buffersize,
-    [framesize](size_t index)
-    {
-      auto input = new InputFrame();
-      input->index = index;
-      input->frame.resize(framesize);
-      return input;
-    },
-    [](InputFrame* input)
-    {
-      delete input;
-    })
+  audio_block_size(blocksize ? blocksize : framesize),
+  audio_sync_semaphore(0),
+  audio_stream_latency(0),
+  audio_events("Audio source")
 {
 }
 
@@ -58,7 +49,7 @@ void AudioSource::open()
         continue;
       }
 
-      if (device.inputChannels < 1)
+      if (device.inputChannels < channels())
       {
         continue;
       }
@@ -84,12 +75,12 @@ void AudioSource::open()
 
   RtAudio::StreamParameters stream_parameters;
   stream_parameters.deviceId = id.value();
-  stream_parameters.nChannels = 1;
+  stream_parameters.nChannels = static_cast<uint32_t>(channels());
   stream_parameters.firstChannel = 0;
 
   const RtAudioFormat stream_format = (typeid(sample_t) == typeid(float)) ? RTAUDIO_FLOAT32 : RTAUDIO_FLOAT64;
   uint32_t stream_samplerate = device.preferredSampleRate;
-  uint32_t stream_framesize = static_cast<uint32_t>(framesize());
+  uint32_t stream_framesize = static_cast<uint32_t>(audio_block_size);
 
   for (const uint32_t native_samplerate : device.sampleRates)
   {
@@ -104,7 +95,7 @@ void AudioSource::open()
 
   stream_framesize /= audio_samplerate_converter.quotient();
 
-  if (stream_samplerate != samplerate())
+  if (stream_samplerate != samplerate() || stream_framesize != framesize())
   {
     LOG(INFO) << $("Opening audio source stream with sr={0} and fs={1}.",
                    stream_samplerate, stream_framesize);
@@ -121,12 +112,22 @@ void AudioSource::open()
     nullptr,
     &AudioSource::error);
 
-  if (stream_framesize * audio_samplerate_converter.quotient() != framesize())
-  {
-    throw std::runtime_error(
-      $("Unexpected audio source stream frame size {0} * {2} != {1}!",
-        stream_framesize, framesize(), audio_samplerate_converter.quotient()));
-  }
+  // the device may have chosen a different block size,
+  // which is fine as long as the ring can hold it
+
+  const size_t blocksize = static_cast<size_t>(stream_framesize * audio_samplerate_converter.quotient());
+  const size_t blocks = (blocksize + framesize() - 1) / framesize();
+
+  audio_block_buffer.resize(blocksize * channels());
+  audio_channel_buffer.resize(framesize() * channels());
+  audio_frame_buffer = std::make_unique<Ring<sample_t>>((buffersize() + blocks) * framesize() * channels());
+
+  // the reported stream latency may be zero if not supported
+  // by the host api, so count at least one device block
+
+  const size_t latency = static_cast<size_t>(audio.getStreamLatency() * audio_samplerate_converter.quotient());
+
+  audio_stream_latency = std::max(latency, blocksize);
 }
 
 void AudioSource::close()
@@ -142,6 +143,11 @@ void AudioSource::close()
   }
 }
 
+size_t AudioSource::latency() const
+{
+  return audio_frame_buffer ? audio_frame_buffer->size() / channels() + audio_stream_latency : 0;
+}
+
 void AudioSource::start()
 {
   if (!audio.isStreamOpen())
@@ -172,52 +178,78 @@ void AudioSource::stop()
   audio.stopStream();
 }
 
-bool AudioSource::read(const size_t index, std::function<void(const voyx::vector<sample_t> frame)> callback)
+bool AudioSource::read(const size_t index, voyx::function_ref<void(const voyx::vector<sample_t> frame)> callback)
 {
-  const bool ok = audio_frame_buffer.read(timeout(), [&](InputFrame& input)
-  {
-    callback(input.frame);
-  });
+  voyxassert(audio_frame_buffer != nullptr);
+
+  const size_t samples = framesize() * channels();
 
-  if (!ok)
+  while (audio_frame_buffer->size() < samples)
   {
-    LOG(WARNING) << $("Audio source fifo underflow!");
+    if (!audio_sync_semaphore.try_acquire_for(timeout()))
+    {
+      LOG(WARNING) << $("Audio source fifo underflow!");
+      return false;
+    }
   }
 
-  return ok;
+  // discard obsolete notifications
+  while (audio_sync_semaphore.try_acquire()) {}
+
+  return audio_frame_buffer->read(samples, [&](const voyx::vector<sample_t> frame)
+  {
+    if (channels() == 1)
+    {
+      callback(frame);
+      return;
+    }
+
+    voyx::matrix<sample_t> planes(audio_channel_buffer, framesize());
+
+    $$::deinterleave(frame.data(), planes);
+
+    callback(audio_channel_buffer);
+  });
 }
 
 int AudioSource::callback(void* output_frame_data, void* input_frame_data, uint32_t framesize, double timestamp, RtAudioStreamStatus status, void* $this)
 {
   auto& audio_frame_buffer = static_cast<AudioSource*>($this)->audio_frame_buffer;
   auto& audio_samplerate_converter = static_cast<AudioSource*>($this)->audio_samplerate_converter;
+  auto& audio_events = static_cast<AudioSource*>($this)->audio_events;
+  auto& audio_block_buffer = static_cast<AudioSource*>($this)->audio_block_buffer;
+  auto& audio_sync_semaphore = static_cast<AudioSource*>($this)->audio_sync_semaphore;
+
+  const size_t channels = static_cast<AudioSource*>($this)->channels();
+  const size_t blocksize = static_cast<size_t>(framesize * audio_samplerate_converter.quotient()) * channels;
 
-  const auto ok = audio_frame_buffer.write([&](InputFrame& input)
+  if (blocksize > audio_block_buffer.size())
   {
-    if (framesize * audio_samplerate_converter.quotient() != input.frame.size())
-    {
-      LOG(WARNING) << $("Unexpected input frame size {0} * {2} != {1}!",
-                        framesize, input.frame.size(), audio_samplerate_converter.quotient());
-    }
+    audio_events.push(EventLog::Code::FrameSize,
+                      blocksize, audio_block_buffer.size());
+  }
+  else
+  {
+    voyx::vector<sample_t> src = { static_cast<sample_t*>(input_frame_data), framesize * channels };
+    voyx::vector<sample_t> dst = { audio_block_buffer.data(), blocksize };
 
-    voyx::vector<sample_t> src = { static_cast<sample_t*>(input_frame_data), framesize };
-    voyx::vector<sample_t> dst = { input.frame.data(), input.frame.size() };
+    audio_samplerate_converter(src, dst, channels);
 
-    audio_samplerate_converter(src, dst);
-  });
+    if (!audio_frame_buffer->write(dst.data(), dst.size()))
+    {
+      audio_events.push(EventLog::Code::FifoOverflow);
+    }
 
-  if (!ok)
-  {
-    LOG(WARNING) << $("Audio source fifo overflow!");
+    audio_sync_semaphore.release();
   }
 
   if (status == RTAUDIO_INPUT_OVERFLOW)
   {
-    LOG(WARNING) << $("Audio source stream overflow!");
+    audio_events.push(EventLog::Code::StreamOverflow);
   }
   else if (status)
   {
-    LOG(WARNING) << $("Audio source stream status {0}!", status);
+    audio_events.push(EventLog::Code::StreamStatus, status);
   }
 
   return 0;
@@ -3,8 +3,8 @@
 #include <voyx/Source.h>
 #include <voyx/etc/WAV.h>
 
-FileSink::FileSink(const std::string& path, double samplerate, size_t framesize, size_t buffersize) :
-  Sink(samplerate, framesize, buffersize),
+FileSink::FileSink(const std::string& path, double samplerate, size_t framesize, size_t buffersize, size_t channels) :
+  Sink(samplerate, framesize, buffersize, channels),
   path(path),
   data(0)
 {
@@ -17,7 +17,7 @@ void FileSink::open()
 
 void FileSink::close()
 {
-  WAV::write(path, data, samplerate());
+  WAV::write(path, data, samplerate(), channels());
 }
 
 bool FileSink::write(const size_t index, const voyx::vector<sample_t> frame)
@@ -27,10 +27,7 @@ bool FileSink::write(const size_t index, const voyx::vector<sample_t> frame)
 
   data.resize(newsize);
 
-  for (size_t i = 0; i < frame.size(); ++i)
-  {
-    data[i + oldsize] = frame[i];
-  }
+  $$::interleave(voyx::matrix<sample_t>(frame, framesize()), data.data() + oldsize);
 
   return true;
 }
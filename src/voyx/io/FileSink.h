@@ -8,7 +8,7 @@ class FileSink : public Sink<sample_t>
 
 public:
 
-  FileSink(const std::string& path, double samplerate, size_t framesize, size_t buffersize);
+  FileSink(const std::string& path, double samplerate, size_t framesize, size_t buffersize, size_t channels = 1);
 
   void open() override;
   void close() override;
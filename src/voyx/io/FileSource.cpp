@@ -3,17 +3,29 @@
 #include <voyx/Source.h>
 #include <voyx/etc/WAV.h>
 
-FileSource::FileSource(const std::string& path, double samplerate, size_t framesize, size_t buffersize) :
-  Source(samplerate, framesize, buffersize),
+FileSource::FileSource(const std::string& path, double samplerate, size_t framesize, size_t buffersize, bool loop, size_t channels) :
+  Source(samplerate, framesize, buffersize, channels),
   path(path),
+  loop(loop),
   data(0),
-  frame(framesize)
+  frame(framesize * channels)
 {
 }
 
+size_t FileSource::frames() const
+{
+  return loop ? 0 : (data.size() + frame.size() - 1) / frame.size();
+}
+
 void FileSource::open()
 {
-  WAV::read(path, data, samplerate());
+  WAV::read(path, data, samplerate(), channels());
+
+  if (data.empty())
+  {
+    throw std::runtime_error(
+      $("No samples in \"{0}\"!", path));
+  }
 }
 
 void FileSource::close()
@@ -21,15 +33,36 @@ void FileSource::close()
   data.clear();
 }
 
-bool FileSource::read(const size_t index, std::function<void(const voyx::vector<sample_t> frame)> callback)
+bool FileSource::read(const size_t index, voyx::function_ref<void(const voyx::vector<sample_t> frame)> callback)
 {
   const size_t offset = index * frame.size();
 
-  for (size_t i = 0; i < frame.size(); ++i)
+  // the file data is interleaved, while the frame holds one channel after another
+  const size_t channels = this->channels();
+  const size_t samples = framesize();
+
+  if (loop)
   {
-    const size_t j = (i + offset) % data.size();
+    for (size_t i = 0; i < frame.size(); ++i)
+    {
+      const size_t j = (i + offset) % data.size();
+
+      frame[i % channels * samples + i / channels] = data[j];
+    }
+  }
+  else
+  {
+    if (offset >= data.size())
+    {
+      return false;
+    }
+
+    for (size_t i = 0; i < frame.size(); ++i)
+    {
+      const size_t j = i + offset;
 
-    frame[i] = data[j];
+      frame[i % channels * samples + i / channels] = (j < data.size()) ? data[j] : 0;
+    }
   }
 
   callback(frame);
@@ -0,0 +1,39 @@
+#include <voyx/io/MemorySink.h>
+
+#include <voyx/Source.h>
+
+MemorySink::MemorySink(voyx::vector<sample_t> data, double samplerate, size_t framesize, size_t buffersize) :
+  Sink(samplerate, framesize, buffersize),
+  data(data)
+{
+}
+
+bool MemorySink::write(const size_t index, const voyx::vector<sample_t> frame)
+{
+  const size_t offset = index * frame.size();
+
+  if (offset >= data.size())
+  {
+    return false;
+  }
+
+  const size_t size = std::min(frame.size(), data.size() - offset);
+
+  std::copy(frame.data(), frame.data() + size, data.data() + offset);
+
+  return true;
+}
+
+bool MemorySink::write(const size_t index, voyx::function_ref<void(voyx::vector<sample_t> frame)> callback)
+{
+  const size_t offset = index * framesize();
+
+  if (offset + framesize() > data.size())
+  {
+    return Sink::write(index, callback);
+  }
+
+  callback(voyx::vector<sample_t>(data.data() + offset, framesize()));
+
+  return true;
+}
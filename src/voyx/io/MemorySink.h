@@ -0,0 +1,20 @@
+#pragma once
+
+#include <voyx/Header.h>
+#include <voyx/io/Sink.h>
+
+class MemorySink : public Sink<sample_t>
+{
+
+public:
+
+  MemorySink(voyx::vector<sample_t> data, double samplerate, size_t framesize, size_t buffersize);
+
+  bool write(const size_t index, const voyx::vector<sample_t> frame) override;
+  bool write(const size_t index, voyx::function_ref<void(voyx::vector<sample_t> frame)> callback) override;
+
+private:
+
+  voyx::vector<sample_t> data;
+
+};
@@ -0,0 +1,36 @@
+#include <voyx/io/MemorySource.h>
+
+#include <voyx/Source.h>
+
+MemorySource::MemorySource(const voyx::vector<sample_t> data, double samplerate, size_t framesize, size_t buffersize) :
+  Source(samplerate, framesize, buffersize),
+  data(data),
+  frame(framesize)
+{
+}
+
+size_t MemorySource::frames() const
+{
+  return (data.size() + frame.size() - 1) / frame.size();
+}
+
+bool MemorySource::read(const size_t index, voyx::function_ref<void(const voyx::vector<sample_t> frame)> callback)
+{
+  const size_t offset = index * frame.size();
+
+  if (offset >= data.size())
+  {
+    return false;
+  }
+
+  for (size_t i = 0; i < frame.size(); ++i)
+  {
+    const size_t j = i + offset;
+
+    frame[i] = (j < data.size()) ? data[j] : 0;
+  }
+
+  callback(frame);
+
+  return true;
+}
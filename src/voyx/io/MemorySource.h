@@ -0,0 +1,23 @@
+#pragma once
+
+#include <voyx/Header.h>
+#include <voyx/io/Source.h>
+
+class MemorySource : public Source<sample_t>
+{
+
+public:
+
+  MemorySource(const voyx::vector<sample_t> data, double samplerate, size_t framesize, size_t buffersize);
+
+  size_t frames() const override;
+
+  bool read(const size_t index, voyx::function_ref<void(const voyx::vector<sample_t> frame)> callback) override;
+
+private:
+
+  const voyx::vector<sample_t> data;
+
+  std::vector<sample_t> frame;
+
+};
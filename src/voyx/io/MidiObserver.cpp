@@ -5,9 +5,20 @@
 MidiObserver::MidiObserver(const std::string& name, const double concertpitch) :
   midi_device_name(name),
   midi_concert_pitch(concertpitch),
-  midi_key_state(128),
-  midi_control_sustain(false)
+  midi_sequence(0)
 {
+  for (size_t key = 0; key < midi_key_frequencies.size(); ++key)
+  {
+    midi_key_frequencies[key] = $$::midi::freq(double(key), concertpitch);
+  }
+
+  midi_state.velocities.fill(0);
+  midi_state.frequencies.fill(0);
+  midi_state.count = 0;
+  midi_state.sustain = false;
+
+  midi_snapshot = midi_state;
+
   midi.setErrorCallback(&MidiObserver::error, this);
 
   start();
@@ -23,31 +34,77 @@ double MidiObserver::concertpitch() const
   return midi_concert_pitch;
 }
 
-std::vector<int> MidiObserver::state()
+void MidiObserver::snapshot(Snapshot& snapshot) const
 {
-  std::lock_guard lock(mutex);
-  return midi_key_state;
+  // seqlock reader, an odd sequence number indicates a pending write
+
+  while (true)
+  {
+    const size_t sequence = midi_sequence.load(std::memory_order_acquire);
+
+    if (sequence & 1)
+    {
+      continue;
+    }
+
+    snapshot = midi_snapshot;
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    if (midi_sequence.load(std::memory_order_relaxed) == sequence)
+    {
+      break;
+    }
+  }
 }
 
-std::vector<double> MidiObserver::frequencies()
+std::shared_ptr<MidiObserver::Events> MidiObserver::subscribe()
+{
+  auto queue = std::make_shared<Events>(1024);
+
+  std::lock_guard lock(midi_events_mutex);
+
+  midi_events.push_back(queue);
+
+  return queue;
+}
+
+size_t MidiObserver::events(Events& queue, const double samplerate, const size_t framesize, std::span<Event> events)
 {
-  const std::vector<int> state = this->state();
+  voyxassert(framesize > 0);
 
-  std::vector<double> frequencies;
+  const auto now = std::chrono::steady_clock::now();
+  const double duration = framesize / samplerate;
 
-  frequencies.reserve(state.size());
+  size_t count = 0;
 
-  for (double key = 0; key < state.size(); ++key)
+  while (count < events.size() && queue.try_dequeue(events[count]))
   {
-    if (state[key])
-    {
-      const double frequency = $$::midi::freq(key, concertpitch());
+    Event& event = events[count++];
 
-      frequencies.push_back(frequency);
-    }
+    const double age = std::chrono::duration<double>(now - event.timestamp).count();
+    const double offset = std::round((duration - age) * samplerate);
+
+    event.offset = static_cast<size_t>(std::clamp(offset, 0.0, double(framesize - 1)));
   }
 
-  return frequencies;
+  return count;
+}
+
+std::vector<int> MidiObserver::state()
+{
+  Snapshot snapshot;
+  this->snapshot(snapshot);
+
+  return { snapshot.velocities.begin(), snapshot.velocities.end() };
+}
+
+std::vector<double> MidiObserver::frequencies()
+{
+  Snapshot snapshot;
+  this->snapshot(snapshot);
+
+  return { snapshot.notes().begin(), snapshot.notes().end() };
 }
 
 std::vector<double> MidiObserver::mask()
@@ -74,8 +131,10 @@ std::vector<double> MidiObserver::imask()
 
 bool MidiObserver::sustain()
 {
-  std::lock_guard lock(mutex);
-  return midi_control_sustain;
+  Snapshot snapshot;
+  this->snapshot(snapshot);
+
+  return snapshot.sustain;
 }
 
 void MidiObserver::start()
@@ -131,6 +190,77 @@ void MidiObserver::stop()
   }
 }
 
+void MidiObserver::publish()
+{
+  // seqlock writer, only invoked by the midi callback thread
+
+  midi_state.count = 0;
+
+  for (size_t key = 0; key < midi_state.velocities.size(); ++key)
+  {
+    if (midi_state.velocities[key])
+    {
+      midi_state.frequencies[midi_state.count++] = midi_key_frequencies[key];
+    }
+  }
+
+  const size_t sequence = midi_sequence.load(std::memory_order_relaxed);
+
+  midi_sequence.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  midi_snapshot = midi_state;
+
+  midi_sequence.store(sequence + 2, std::memory_order_release);
+}
+
+void MidiObserver::enqueue(const Event::Type type, const int key, const int value)
+{
+  const Event event =
+  {
+    type,
+    key,
+    value,
+    midi_key_frequencies[key],
+    midi_clock,
+    0
+  };
+
+  // the midi callback thread is not time critical,
+  // so just lock out new subscriptions meanwhile
+
+  std::lock_guard lock(midi_events_mutex);
+
+  std::erase_if(midi_events, [](const std::weak_ptr<Events>& queue)
+  {
+    return queue.expired();
+  });
+
+  for (auto& subscriber : midi_events)
+  {
+    // drop the event if the subscriber is not consuming,
+    // since the snapshot remains up to date anyway
+    if (auto queue = subscriber.lock())
+    {
+      queue->try_enqueue(event);
+    }
+  }
+}
+
+void MidiObserver::tick(const double delta)
+{
+  // the rtmidi timestamp is the delta time since the previous message,
+  // so accumulate it but resync to the system clock in case of drift
+
+  const auto now = std::chrono::steady_clock::now();
+  const auto next = midi_clock + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+    std::chrono::duration<double>(delta));
+
+  const bool drift = (next > now) || (now - next > std::chrono::milliseconds(10));
+
+  midi_clock = drift ? now : next;
+}
+
 void MidiObserver::dump(std::vector<unsigned char>* message)
 {
   const std::vector<uint8_t> bytes(
@@ -153,6 +283,10 @@ void MidiObserver::callback(double timestamp, std::vector<unsigned char>* messag
 
   // dump(message);
 
+  auto observer = static_cast<MidiObserver*>($this);
+
+  observer->tick(timestamp);
+
   if ((*message).empty())
   {
     return;
@@ -162,14 +296,9 @@ void MidiObserver::callback(double timestamp, std::vector<unsigned char>* messag
 
   if (reset)
   {
-    auto observer = static_cast<MidiObserver*>($this);
-
-    std::lock_guard lock(observer->mutex);
-
-    std::fill(
-      observer->midi_key_state.begin(),
-      observer->midi_key_state.end(),
-      0);
+    observer->midi_state.velocities.fill(0);
+    observer->publish();
+    observer->enqueue(Event::Type::Reset, 0, 0);
 
     // LOG(INFO) << "MIDI: reset";
 
@@ -193,11 +322,9 @@ void MidiObserver::callback(double timestamp, std::vector<unsigned char>* messag
     {
       const bool state = (*message)[2] >= 64;
 
-      auto observer = static_cast<MidiObserver*>($this);
-
-      std::lock_guard lock(observer->mutex);
-
-      observer->midi_control_sustain = state;
+      observer->midi_state.sustain = state;
+      observer->publish();
+      observer->enqueue(Event::Type::Sustain, 0, state);
     }
   }
   else
@@ -210,11 +337,9 @@ void MidiObserver::callback(double timestamp, std::vector<unsigned char>* messag
 
     if (on || off)
     {
-      auto observer = static_cast<MidiObserver*>($this);
-
-      std::lock_guard lock(observer->mutex);
-
-      observer->midi_key_state[key] = on ? velocity : 0;
+      observer->midi_state.velocities[key] = on ? velocity : 0;
+      observer->publish();
+      observer->enqueue(Event::Type::Note, key, on ? velocity : 0);
 
       // LOG(INFO) << $("MIDI: {0} key={1:03d} velocity={2:03d}", on ? "on " : "off", key, velocity);
     }
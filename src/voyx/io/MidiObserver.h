@@ -4,16 +4,78 @@
 
 #include <RtMidi.h>
 
+#include <readerwriterqueue.h>
+
 class MidiObserver
 {
 
 public:
 
+  /**
+   * Consistent copy of the key and control state,
+   * including the frequencies of the pressed keys in ascending order.
+   **/
+  struct Snapshot
+  {
+    std::array<int, 128> velocities;
+    std::array<double, 128> frequencies;
+    size_t count;
+    bool sustain;
+
+    std::span<const double> notes() const
+    {
+      return { frequencies.data(), count };
+    }
+  };
+
+  /**
+   * Timestamped note, sustain or reset message.
+   **/
+  struct Event
+  {
+    enum class Type { Note, Sustain, Reset };
+
+    Type type;
+    int key;
+    int value;
+    double frequency;
+    std::chrono::steady_clock::time_point timestamp;
+    size_t offset;
+  };
+
+  /**
+   * Event queue of a single consumer, e.g. of one pipeline instance.
+   **/
+  typedef moodycamel::ReaderWriterQueue<Event> Events;
+
   MidiObserver(const std::string& name, const double concertpitch);
   ~MidiObserver();
 
   double concertpitch() const;
 
+  /**
+   * Lock-free and allocation-free, so it can be called on the audio thread.
+   **/
+  void snapshot(Snapshot& snapshot) const;
+
+  /**
+   * Returns a new queue, which receives all subsequent events.
+   * Each consumer needs its own queue, since several pipeline instances
+   * (e.g. per channel or per session) share the same observer.
+   * The queue is released as soon as the consumer drops it.
+   **/
+  std::shared_ptr<Events> subscribe();
+
+  /**
+   * Pops the events received by the specified queue since the last call
+   * and maps their timestamps to sample offsets within a frame of the specified size ending now.
+   * So each event is delayed by exactly one frame instead of being
+   * quantized to the next frame boundary.
+   *
+   * Lock-free and allocation-free, but expects a single consumer thread per queue.
+   **/
+  size_t events(Events& queue, const double samplerate, const size_t framesize, std::span<Event> events);
+
   std::vector<int> state();
   std::vector<double> frequencies();
 
@@ -30,12 +92,21 @@ private:
   const std::string midi_device_name;
   const double midi_concert_pitch;
 
-  std::vector<int> midi_key_state;
-  bool midi_control_sustain;
+  std::array<double, 128> midi_key_frequencies;
+
+  Snapshot midi_state;
+  Snapshot midi_snapshot;
+  std::atomic<size_t> midi_sequence;
+
+  std::vector<std::weak_ptr<Events>> midi_events;
+  std::mutex midi_events_mutex;
+  std::chrono::steady_clock::time_point midi_clock;
 
   RtMidiIn midi;
 
-  std::mutex mutex;
+  void publish();
+  void enqueue(const Event::Type type, const int key, const int value);
+  void tick(const double delta);
 
   static void dump(std::vector<unsigned char>* message);
   static void callback(double timestamp, std::vector<unsigned char>* message, void* $this);
@@ -15,7 +15,7 @@ NoiseSource::NoiseSource(double amplitude, double samplerate, size_t framesize,
 {
 }
 
-bool NoiseSource::read(const size_t index, std::function<void(const voyx::vector<sample_t> frame)> callback)
+bool NoiseSource::read(const size_t index, voyx::function_ref<void(const voyx::vector<sample_t> frame)> callback)
 {
   for (size_t i = 0; i < frame.size(); ++i)
   {
@@ -12,7 +12,7 @@ public:
   NoiseSource(double samplerate, size_t framesize, size_t buffersize);
   NoiseSource(double amplitude, double samplerate, size_t framesize, size_t buffersize);
 
-  bool read(const size_t index, std::function<void(const voyx::vector<sample_t> frame)> callback) override;
+  bool read(const size_t index, voyx::function_ref<void(const voyx::vector<sample_t> frame)> callback) override;
 
 private:
 
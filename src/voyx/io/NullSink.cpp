@@ -2,8 +2,8 @@
 
 #include <voyx/Source.h>
 
-NullSink::NullSink(double samplerate, size_t framesize, size_t buffersize) :
-  Sink(samplerate, framesize, buffersize)
+NullSink::NullSink(double samplerate, size_t framesize, size_t buffersize, size_t channels) :
+  Sink(samplerate, framesize, buffersize, channels)
 {
 }
 
@@ -8,7 +8,7 @@ class NullSink : public Sink<sample_t>
 
 public:
 
-  NullSink(double samplerate, size_t framesize, size_t buffersize);
+  NullSink(double samplerate, size_t framesize, size_t buffersize, size_t channels = 1);
 
   bool write(const size_t index, const voyx::vector<sample_t> frame) override;
 
@@ -2,13 +2,13 @@
 
 #include <voyx/Source.h>
 
-NullSource::NullSource(double samplerate, size_t framesize, size_t buffersize) :
-  Source(samplerate, framesize, buffersize),
-  frame(framesize)
+NullSource::NullSource(double samplerate, size_t framesize, size_t buffersize, size_t channels) :
+  Source(samplerate, framesize, buffersize, channels),
+  frame(framesize * channels)
 {
 }
 
-bool NullSource::read(const size_t index, std::function<void(const voyx::vector<sample_t> frame)> callback)
+bool NullSource::read(const size_t index, voyx::function_ref<void(const voyx::vector<sample_t> frame)> callback)
 {
   callback(frame);
 
@@ -8,9 +8,9 @@ class NullSource : public Source<sample_t>
 
 public:
 
-  NullSource(double samplerate, size_t framesize, size_t buffersize);
+  NullSource(double samplerate, size_t framesize, size_t buffersize, size_t channels = 1);
 
-  bool read(const size_t index, std::function<void(const voyx::vector<sample_t> frame)> callback) override;
+  bool read(const size_t index, voyx::function_ref<void(const voyx::vector<sample_t> frame)> callback) override;
 
 private:
 
@@ -16,7 +16,7 @@ SineSource::SineSource(double amplitude, double frequency, double samplerate, si
 {
 }
 
-bool SineSource::read(const size_t index, std::function<void(const voyx::vector<sample_t> frame)> callback)
+bool SineSource::read(const size_t index, voyx::function_ref<void(const voyx::vector<sample_t> frame)> callback)
 {
   for (size_t i = 0; i < frame.size(); ++i)
   {
@@ -8,10 +8,11 @@ class Sink
 
 public:
 
-  Sink(double samplerate, size_t framesize, size_t buffersize) :
+  Sink(double samplerate, size_t framesize, size_t buffersize, size_t channels = 1) :
     sink_samplerate(samplerate),
     sink_framesize(framesize),
     sink_buffersize(buffersize),
+    sink_channels(channels),
     sink_timeout(std::chrono::milliseconds(
       static_cast<std::chrono::milliseconds::rep>(
         std::ceil(1e3 * framesize / samplerate)))) {}
@@ -21,6 +22,7 @@ public:
   double samplerate() const { return sink_samplerate; }
   size_t framesize() const { return sink_framesize; }
   size_t buffersize() const { return sink_buffersize; }
+  size_t channels() const { return sink_channels; }
   const std::chrono::milliseconds& timeout() const { return sink_timeout; }
 
   virtual void open() {};
@@ -29,14 +31,39 @@ public:
   virtual void start() {};
   virtual void stop() {};
 
+  /**
+   * Consumes the specified frame. Multichannel frames consist of
+   * framesize() samples per channel, stored one channel after another.
+   **/
   virtual bool write(const size_t index, const voyx::vector<T> frame) = 0;
   virtual bool sync() { return true; }
 
+  /**
+   * Returns the number of samples currently buffered
+   * between the last write and the playback.
+   **/
+  virtual size_t latency() const { return 0; }
+
+  /**
+   * Lets the callback render the frame in place, if the sink supports it.
+   * Otherwise the frame is rendered into an intermediate buffer
+   * and passed to the regular write function.
+   **/
+  virtual bool write(const size_t index, voyx::function_ref<void(voyx::vector<T> frame)> callback)
+  {
+    sink_frame.resize(sink_framesize * sink_channels);
+    callback(sink_frame);
+    return write(index, sink_frame);
+  }
+
 private:
 
   const double sink_samplerate;
   const size_t sink_framesize;
   const size_t sink_buffersize;
+  const size_t sink_channels;
   const std::chrono::milliseconds sink_timeout;
 
+  std::vector<T> sink_frame;
+
 };
@@ -8,10 +8,11 @@ class Source
 
 public:
 
-  Source(double samplerate, size_t framesize, size_t buffersize) :
+  Source(double samplerate, size_t framesize, size_t buffersize, size_t channels = 1) :
     source_samplerate(samplerate),
     source_framesize(framesize),
     source_buffersize(buffersize),
+    source_channels(channels),
     source_timeout(std::chrono::milliseconds(
       static_cast<std::chrono::milliseconds::rep>(
         std::ceil(1e3 * framesize / samplerate)))) {}
@@ -21,21 +22,39 @@ public:
   double samplerate() const { return source_samplerate; }
   size_t framesize() const { return source_framesize; }
   size_t buffersize() const { return source_buffersize; }
+  size_t channels() const { return source_channels; }
   const std::chrono::milliseconds& timeout() const { return source_timeout; }
 
+  /**
+   * Returns the total number of available frames
+   * or zero, if the source is endless.
+   **/
+  virtual size_t frames() const { return 0; }
+
+  /**
+   * Returns the number of samples currently buffered
+   * between the capture and the next read.
+   **/
+  virtual size_t latency() const { return 0; }
+
   virtual void open() {};
   virtual void close() {};
 
   virtual void start() {};
   virtual void stop() {};
 
-  virtual bool read(const size_t index, std::function<void(const voyx::vector<T> frame)> callback) = 0;
+  /**
+   * Passes the next frame to the callback. Multichannel frames consist of
+   * framesize() samples per channel, stored one channel after another.
+   **/
+  virtual bool read(const size_t index, voyx::function_ref<void(const voyx::vector<T> frame)> callback) = 0;
 
 private:
 
   const double source_samplerate;
   const size_t source_framesize;
   const size_t source_buffersize;
+  const size_t source_channels;
   const std::chrono::milliseconds source_timeout;
 
 };
@@ -17,7 +17,7 @@ SweepSource::SweepSource(double amplitude, std::pair<double, double> frequencies
 {
 }
 
-bool SweepSource::read(const size_t index, std::function<void(const voyx::vector<sample_t> frame)> callback)
+bool SweepSource::read(const size_t index, voyx::function_ref<void(const voyx::vector<sample_t> frame)> callback)
 {
   for (size_t i = 0; i < frame.size(); ++i)
   {
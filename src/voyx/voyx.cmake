@@ -16,7 +16,8 @@ target_include_directories(voyx
   PRIVATE "${CMAKE_CURRENT_LIST_DIR}/..")
 
 target_link_libraries(voyx
-  PRIVATE cxxopts
+  PRIVATE voyx_options
+          cxxopts
           dr
           easyloggingpp
           fmt